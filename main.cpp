@@ -1,52 +1,348 @@
 #define OLC_PGE_APPLICATION
 
+// Build with -DWORLD_HEADLESS to run a fixed number of frames without a window, e.g. for profiling
+#if defined(WORLD_HEADLESS)
+#define OLC_PLATFORM_CUSTOM_EX olc::Platform_Headless
+#define OLC_GFX_CUSTOM_EX
+#define OLC_RENDERER_CUSTOM_EX olc::Renderer_Software
+#ifndef WORLD_HEADLESS_FRAMES
+#define WORLD_HEADLESS_FRAMES 600
+#endif
+#endif
+
+// Build with -DWORLD_PIPELINED to make the next frame while the engine presents the last one
+#if defined(WORLD_PIPELINED)
+constexpr bool PIPELINED = true;
+#else
+constexpr bool PIPELINED = false;
+#endif
+
+// The scene only changes for input and new worlds, so frames are only made then and at most 60 a second.
+// Headless builds make every frame as fast as they can to profile them, unless built with -DWORLD_IDLE
+#if !defined(WORLD_HEADLESS) || defined(WORLD_IDLE)
+constexpr bool IDLE = true;
+constexpr float FRAME_RATE_LIMIT = 60.0f;
+#else
+constexpr bool IDLE = false;
+constexpr float FRAME_RATE_LIMIT = 0.0f;
+#endif
+
 #include "olcPixelGameEngine.h"
 #include <vector>
 #include <chrono>
+#include <map>
+#include <list>
+#include <unordered_map>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <climits>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <cstdlib>
+#include <new>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Heap allocations made by the current thread, counted by the replaced global operator new below.
+// Work handed to other threads has to add its count back to the thread it works for
+inline thread_local size_t allocationCount = 0;
+
+void *operator new(std::size_t size) {
+    allocationCount++;
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+// GCC pairs the inlined malloc and free of the replaced operators with the new expressions and warns about a mismatch
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
 namespace res {
 
-    struct Tree {
-        int x;
-        int y;
-        int radius;
-        int height;
-        int width;
-        olc::Pixel barkColor;
-        olc::Pixel leafColor;
-
-        Tree(int x, int y, int r, int h, int w, olc::Pixel barkColor, olc::Pixel leafColor)
-                : x(x), y(y), radius(r), height(h), width(w), barkColor(barkColor), leafColor(leafColor) {}
+    // Trees as columns, tree i is the i-th entry of every column. Colors are indices into the tree palette
+    struct TreeList {
+        std::vector<int32_t> x;
+        std::vector<int32_t> y;
+        std::vector<int32_t> radius;
+        std::vector<int32_t> height;
+        std::vector<int32_t> width;
+        std::vector<uint8_t> barkColor;
+        std::vector<uint8_t> leafColor;
+
+        [[nodiscard]] size_t size() const {
+            return x.size();
+        }
+
+        void reserve(size_t n) {
+            x.reserve(n);
+            y.reserve(n);
+            radius.reserve(n);
+            height.reserve(n);
+            width.reserve(n);
+            barkColor.reserve(n);
+            leafColor.reserve(n);
+        }
+
+        void clear() {
+            x.clear();
+            y.clear();
+            radius.clear();
+            height.clear();
+            width.clear();
+            barkColor.clear();
+            leafColor.clear();
+        }
+
+        void add(int treeX, int treeY, int r, int h, int w, uint8_t bark, uint8_t leaf) {
+            x.push_back(treeX);
+            y.push_back(treeY);
+            radius.push_back(r);
+            height.push_back(h);
+            width.push_back(w);
+            barkColor.push_back(bark);
+            leafColor.push_back(leaf);
+        }
+
+        // Moves the trees from index first on by dx
+        void shift(size_t first, int dx) {
+            for (size_t i = first; i < x.size(); i++)
+                x[i] += dx;
+        }
     };
 
-    struct CloudPart {
-        int x;
-        int y;
-        int r;
-        olc::Pixel color;
+    // Clouds as columns. A cloud is built from overlapping circular parts, but only their union is kept, as runs of
+    // pixels along its rows. Cloud i owns the runs [runBegin[i], runEnd(i)) in row order, run k covers runLength[k]
+    // pixels from (runX[k], runY[k]) on, relative to the cloud. Colors are indices into the cloud palette
+    struct CloudList {
+        std::vector<int32_t> x;
+        std::vector<int32_t> y;
+        std::vector<uint32_t> runBegin;
+
+        std::vector<int16_t> runX;
+        std::vector<int16_t> runY;
+        std::vector<uint16_t> runLength;
+        std::vector<uint8_t> runColor;
+
+        [[nodiscard]] size_t size() const {
+            return x.size();
+        }
+
+        [[nodiscard]] size_t runCount() const {
+            return runX.size();
+        }
+
+        [[nodiscard]] size_t runEnd(size_t i) const {
+            return i + 1 < runBegin.size() ? runBegin[i + 1] : runX.size();
+        }
+
+        // The scratch of the cloud being built is sized for cloudParts parts covering cloudArea pixels
+        void reserve(size_t clouds, size_t runs, size_t cloudParts, size_t cloudArea) {
+            parts.reserve(cloudParts);
+            coverage.reserve(cloudArea);
+            x.reserve(clouds);
+            y.reserve(clouds);
+            runBegin.reserve(clouds);
+            runX.reserve(runs);
+            runY.reserve(runs);
+            runLength.reserve(runs);
+            runColor.reserve(runs);
+        }
+
+        void clear() {
+            x.clear();
+            y.clear();
+            runBegin.clear();
+            runX.clear();
+            runY.clear();
+            runLength.clear();
+            runColor.clear();
+        }
+
+        // Starts a new cloud, the parts added after it make it up once finish() is called
+        void add(int cloudX, int cloudY) {
+            x.push_back(cloudX);
+            y.push_back(cloudY);
+            runBegin.push_back((uint32_t) runX.size());
+            parts.clear();
+        }
+
+        // Later parts cover earlier ones where they overlap
+        void addPart(int px, int py, int r, uint8_t color) {
+            parts.push_back({px - x.back(), py - y.back(), r, color});
+        }
+
+        // Turns the parts of the last cloud into its runs, the pixels are those FillCircle() draws for the parts
+        void finish() {
+            if (parts.empty()) return;
+            int left = INT_MAX, top = INT_MAX, right = INT_MIN, bottom = INT_MIN;
+            for (const auto &part: parts) {
+                left = std::min(left, part.x - part.radius);
+                top = std::min(top, part.y - part.radius);
+                right = std::max(right, part.x + part.radius);
+                bottom = std::max(bottom, part.y + part.radius);
+            }
 
-        CloudPart(int x, int y, int r, uint32_t color) : x(x), y(y), r(r), color(color) {}
+            int width = right - left + 1;
+            coverage.assign((size_t) width * (bottom - top + 1), NO_COLOR);
+            auto span = [&](int from, int to, int row, uint8_t color) {
+                auto cells = coverage.begin() + (ptrdiff_t) (row - top) * width - left;
+                std::fill(cells + from, cells + to + 1, color);
+            };
+            for (const auto &part: parts) {
+                if (part.radius > 0)
+                    olc::raster::FilledCircle(part.x, part.y, part.radius,
+                                              [&](int from, int to, int row) { span(from, to, row, part.color); });
+                else if (part.radius == 0)
+                    span(part.x, part.x, part.y, part.color);
+            }
+
+            for (int row = top; row <= bottom; row++) {
+                const uint8_t *cells = coverage.data() + (size_t) (row - top) * width;
+                for (int col = 0; col < width;) {
+                    int end = col + 1;
+                    while (end < width && cells[end] == cells[col]) end++;
+                    if (cells[col] != NO_COLOR) {
+                        runX.push_back((int16_t) (left + col));
+                        runY.push_back((int16_t) row);
+                        runLength.push_back((uint16_t) (end - col));
+                        runColor.push_back(cells[col]);
+                    }
+                    col = end;
+                }
+            }
+            parts.clear();
+            coverage.clear();
+        }
+
+        // Whether cloud i covers the point (px, py), a search for the row and a look at its runs
+        [[nodiscard]] bool covers(size_t i, int px, int py) const {
+            int dx = px - x[i], dy = py - y[i];
+            auto rows = runY.begin();
+            for (size_t k = std::lower_bound(rows + runBegin[i], rows + runEnd(i), dy) - rows;
+                 k < runEnd(i) && runY[k] == dy; k++)
+                if (dx >= runX[k] && dx < runX[k] + runLength[k]) return true;
+            return false;
+        }
+
+        // Moves the clouds from index first on by dx, the runs are relative to their cloud
+        void shift(size_t first, int dx) {
+            for (size_t i = first; i < x.size(); i++)
+                x[i] += dx;
+        }
+
+    private:
+        static constexpr uint8_t NO_COLOR = 0xff;
+
+        struct Part {
+            int x, y, radius;
+            uint8_t color;
+        };
+
+        // The cloud being built, kept to be reused by the next one
+        std::vector<Part> parts;
+        std::vector<uint8_t> coverage;
     };
 
-    struct Cloud {
-        int x;
-        int y;
-        std::vector<CloudPart *> cloudParts;
+    typedef std::vector<double> NoiseArray;
+
+    // Min, max and sum of a run of heights, runs are merged instead of scanning the heights again
+    struct HeightStats {
+        double min;
+        double max;
+        double sum = 0;
+        size_t count = 0;
 
-        Cloud(int x, int y) : x(x), y(y) {}
+        HeightStats(double min, double max) : min(min), max(max) {}
 
-        ~Cloud() {
-            for (auto &cloudPart: cloudParts)
-                delete cloudPart;
-            cloudParts.clear();
+        void add(double height) {
+            sum += height;
+            count++;
+            if (height < min) min = height;
+            if (height > max) max = height;
+        }
+
+        void merge(const HeightStats &other) {
+            sum += other.sum;
+            count += other.count;
+            if (other.min < min) min = other.min;
+            if (other.max > max) max = other.max;
+        }
+
+        [[nodiscard]] double avg() const {
+            return sum / count;
         }
     };
 
-    typedef std::vector<Tree *> TreeList;
+    // A fixed-width slice of the world, a pure function of (seed, index)
+    struct TerrainChunk {
+        int64_t index = 0;
+        NoiseArray heights;
+        HeightStats stats{DBL_MAX, -DBL_MAX};
+    };
 
-    typedef std::vector<double> NoiseArray;
+    typedef std::map<int64_t, TerrainChunk> ChunkCache;
+
+    // Everything needed to draw a generated world. The renderer draws one while the generator fills another
+    struct WorldState {
+        uint32_t seed = 0;
+        NoiseArray noiseArray;
+        TreeList treeList;
+        CloudList cloudList;
+
+        double minLandHeight{};
+        double maxLandHeight{};
+        double avgLandHeight{};
+
+        int waterBoundHeight{};
+
+        // Heap allocations it took to generate this world
+        size_t allocations = 0;
+
+        WorldState() = default;
+
+        WorldState(const WorldState &) = delete;
 
-    typedef std::vector<Cloud *> CloudList;
+        // Sizes the buffers for the worst case, so regenerating never has to grow them
+        void reserve(size_t columns, size_t trees, size_t clouds, size_t cloudRuns, size_t cloudParts, size_t cloudArea) {
+            noiseArray.reserve(columns);
+            treeList.reserve(trees);
+            cloudList.reserve(clouds, cloudRuns, cloudParts, cloudArea);
+        }
+
+        // Drops the trees and clouds, the memory is kept for the next world
+        void clear() {
+            treeList.clear();
+            cloudList.clear();
+        }
+
+        // Replaces the clouds with the clouds of another world, copying into the existing columns
+        void copyClouds(const WorldState &other) {
+            cloudList = other.cloudList;
+        }
+    };
 }
 
 class ResourceContainer {
@@ -60,8 +356,10 @@ private:
             // BGR color format - 4. is bark color, 1-3 leaves color
             0xff2aa220, 0xff2aa23a, 0xff2bc311, 0xff143a69
     };
+    std::vector<uint32_t> cloudColorPalette = {
+            0xffffffff
+    };
     uint32_t waterColor = 0xffb0811e;
-    uint32_t cloudColor = 0xffffffff;
 public:
     ResourceContainer() = default;
 
@@ -79,37 +377,245 @@ public:
         return waterColor;
     }
 
-    [[nodiscard]] uint32_t getCloudColor() const {
-        return cloudColor;
+    [[nodiscard]] uint32_t getCloudColor(int index) const {
+        return cloudColorPalette[index];
     }
 };
 
+// Distributions for any 32-bit uniform random bit generator, Lehmer32 included. They are bias free and
+// need no division in the common case, unlike the legacy rndInt / rndDouble of Lehmer32
+namespace dist {
+
+    template<typename G>
+    void checkGenerator() {
+        static_assert(G::min() == 0 && G::max() == UINT32_MAX, "a full range 32-bit generator is required");
+    }
+
+    // Integers in [min, max), Lemire's nearly divisionless method - the modulo only runs when a rejection is possible
+    class UniformInt {
+    private:
+        int min;
+        uint32_t range;
+
+    public:
+        UniformInt(int min, int max) : min(min), range((uint32_t) max - (uint32_t) min) {}
+
+        template<typename G>
+        int operator()(G &g) const {
+            checkGenerator<G>();
+            uint64_t m = (uint64_t) g() * range;
+            auto low = (uint32_t) m;
+            if (low < range) {
+                uint32_t threshold = (0u - range) % range;
+                while (low < threshold) {
+                    m = (uint64_t) g() * range;
+                    low = (uint32_t) m;
+                }
+            }
+            return (int) ((uint32_t) min + (uint32_t) (m >> 32));
+        }
+    };
+
+    // Floats in [min, max), 23 random mantissa bits put into [1, 2) and shifted down
+    class UniformFloat {
+    private:
+        float min;
+        float range;
+
+    public:
+        UniformFloat(float min, float max) : min(min), range(max - min) {}
+
+        template<typename G>
+        float operator()(G &g) const {
+            checkGenerator<G>();
+            uint32_t bits = 0x3f800000u | ((uint32_t) g() >> 9);
+            float unit;
+            std::memcpy(&unit, &bits, sizeof(unit));
+            return min + (unit - 1.0f) * range;
+        }
+    };
+
+    // Doubles in [min, max), 52 random mantissa bits taken from two outputs
+    class UniformDouble {
+    private:
+        double min;
+        double range;
+
+    public:
+        UniformDouble(double min, double max) : min(min), range(max - min) {}
+
+        template<typename G>
+        double operator()(G &g) const {
+            checkGenerator<G>();
+            uint64_t high = g();
+            uint64_t low = g();
+            uint64_t bits = 0x3ff0000000000000ull | ((high << 20) ^ (low >> 12));
+            double unit;
+            std::memcpy(&unit, &bits, sizeof(unit));
+            return min + (unit - 1.0) * range;
+        }
+    };
+
+    // Normally distributed doubles, Marsaglia and Tsang's ziggurat with 128 layers
+    class Normal {
+    private:
+        double mean;
+        double stddev;
+
+        struct Tables {
+            uint32_t k[128];
+            double w[128];
+            double f[128];
+
+            Tables() {
+                const double m1 = 2147483648.0;
+                const double v = 9.91256303526217e-3;
+                double d = 3.442619855899, t = d;
+                double q = v / std::exp(-0.5 * d * d);
+                k[0] = (uint32_t) ((d / q) * m1);
+                k[1] = 0;
+                w[0] = q / m1;
+                w[127] = d / m1;
+                f[0] = 1.0;
+                f[127] = std::exp(-0.5 * d * d);
+                for (int i = 126; i >= 1; i--) {
+                    d = std::sqrt(-2.0 * std::log(v / d + std::exp(-0.5 * d * d)));
+                    k[i + 1] = (uint32_t) ((d / t) * m1);
+                    t = d;
+                    f[i] = std::exp(-0.5 * d * d);
+                    w[i] = d / m1;
+                }
+            }
+        };
+
+        static const Tables &tables() {
+            static const Tables instance;
+            return instance;
+        }
+
+        // Uniform in (0, 1), never 0 so it is safe to take the log of
+        template<typename G>
+        static double open(G &g) {
+            return ((double) g() + 0.5) * (1.0 / 4294967296.0);
+        }
+
+        template<typename G>
+        static double standard(G &g) {
+            const Tables &z = tables();
+            const double r = 3.442619855899;
+            while (true) {
+                auto h = (int32_t) g();
+                int i = h & 127;
+                auto magnitude = (uint32_t) std::abs((int64_t) h);
+                double x = h * z.w[i];
+                if (magnitude < z.k[i])
+                    return x;
+                if (i == 0) {
+                    // The tail beyond r is sampled separately
+                    double y;
+                    do {
+                        x = -std::log(open(g)) / r;
+                        y = -std::log(open(g));
+                    } while (y + y < x * x);
+                    return h > 0 ? r + x : -r - x;
+                }
+                if (z.f[i] + open(g) * (z.f[i - 1] - z.f[i]) < std::exp(-0.5 * x * x))
+                    return x;
+            }
+        }
+
+    public:
+        explicit Normal(double mean = 0.0, double stddev = 1.0) : mean(mean), stddev(stddev) {}
+
+        template<typename G>
+        double operator()(G &g) const {
+            checkGenerator<G>();
+            return mean + stddev * standard(g);
+        }
+    };
+}
+
 class Lehmer32 {
+public:
+    // LEGACY keeps the original modulo / divide based rndInt and rndDouble so existing seeds reproduce the same
+    // worlds, FAST routes them through the bias free distributions
+    enum class Mode {
+        LEGACY, FAST
+    };
+
 private:
+    static const uint32_t INCREMENT = 0xe120fc15;
+
     uint32_t lehmerState = 0;
+    Mode mode = Mode::LEGACY;
 
 public:
-    explicit Lehmer32(uint32_t lehmerState = 0) {
+    using result_type = uint32_t;
+
+    explicit Lehmer32(uint32_t lehmerState = 0, Mode mode = Mode::LEGACY) {
         this->lehmerState = lehmerState;
+        this->mode = mode;
     }
 
-    uint32_t get() {
-        lehmerState += 0xe120fc15;
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return UINT32_MAX;
+    }
+
+    result_type operator()() {
+        return get();
+    }
+
+    // The n-th output only depends on lehmerState + n * INCREMENT, which is what makes jumping ahead O(1)
+    static uint32_t hash(uint32_t state) {
         uint64_t tmp;
-        tmp = (uint64_t) lehmerState * 0x4a39b70d;
+        tmp = (uint64_t) state * 0x4a39b70d;
         uint32_t m1 = (tmp >> 32) ^ tmp;
         tmp = (uint64_t) m1 * 0x12fad5c9;
         uint32_t m2 = (tmp >> 32) ^ tmp;
         return m2;
     }
 
+    uint32_t get() {
+        lehmerState += INCREMENT;
+        return hash(lehmerState);
+    }
+
+    [[nodiscard]] uint32_t getState() const {
+        return lehmerState;
+    }
+
+    [[nodiscard]] Mode getMode() const {
+        return mode;
+    }
+
+    // Skips the next n outputs, same as calling get() n times
+    void discard(uint64_t n) {
+        lehmerState += (uint32_t) n * INCREMENT;
+    }
+
+    // Returns the output index places ahead without advancing, at(0) is what the next get() returns
+    [[nodiscard]] uint32_t at(uint64_t index) const {
+        return hash(lehmerState + (uint32_t) (index + 1) * INCREMENT);
+    }
+
+    // Derives a new generator for the given stream id, streams of the same generator do not overlap in practice
+    [[nodiscard]] Lehmer32 split(uint32_t stream) const {
+        return Lehmer32(hash(lehmerState ^ hash(stream ^ 0x9e3779b9)), mode);
+    }
+
     int rndInt(int min, int max) {
+        if (mode == Mode::FAST) return dist::UniformInt(min, max)(*this);
         return (int) (get() % (max - min)) + min;
     }
 
     // Returns a random double between 0.0 and 1.0 - a little fix was made to the code, since id did not return correct values
     double rndDouble(double min, double max) {
-        auto res = ((double) get() / (double) (0x7FFFFFFF)) * (max - min) + min;
+        if (mode == Mode::FAST) return dist::UniformDouble(min, max)(*this);
+        auto res = unfused(((double) get() / (double) (0x7FFFFFFF)) * (max - min)) + min;
         if (res < min) res += (max - min);
         else if (res > max) res -= (max - min);
         return res;
@@ -118,14 +624,552 @@ public:
     bool rndBool() {
         return get() % 2;
     }
+
+    double rndNormal(double mean, double stddev) {
+        return dist::Normal(mean, stddev)(*this);
+    }
+
+    // Batch versions of get(), rndInt(), rndDouble() and rndBool(), the outputs are identical to calling the
+    // scalar functions n times. Only the legacy distributions are vectorized, FAST mode falls back to a loop
+    void fill(uint32_t *out, size_t n) {
+        size_t i = 0;
+#if defined(__AVX512F__)
+        alignas(64) uint32_t lanes[16];
+        for (uint32_t k = 0; k < 16; k++) lanes[k] = lehmerState + (k + 1) * INCREMENT;
+        __m512i state = _mm512_load_si512(lanes);
+        const __m512i step = _mm512_set1_epi32((int) (16 * INCREMENT));
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_si512(out + i, hash16(state));
+            state = _mm512_add_epi32(state, step);
+        }
+#elif defined(__AVX2__)
+        alignas(32) uint32_t lanes[8];
+        for (uint32_t k = 0; k < 8; k++) lanes[k] = lehmerState + (k + 1) * INCREMENT;
+        __m256i state = _mm256_load_si256((const __m256i *) lanes);
+        const __m256i step = _mm256_set1_epi32((int) (8 * INCREMENT));
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_si256((__m256i *) (out + i), hash8(state));
+            state = _mm256_add_epi32(state, step);
+        }
+#elif defined(__SSE2__)
+        alignas(16) uint32_t lanes[4];
+        for (uint32_t k = 0; k < 4; k++) lanes[k] = lehmerState + (k + 1) * INCREMENT;
+        __m128i state = _mm_load_si128((const __m128i *) lanes);
+        const __m128i step = _mm_set1_epi32((int) (4 * INCREMENT));
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_si128((__m128i *) (out + i), hash4(state));
+            state = _mm_add_epi32(state, step);
+        }
+#endif
+        lehmerState += (uint32_t) i * INCREMENT;
+        for (; i < n; i++)
+            out[i] = get();
+    }
+
+    void fillInt(int *out, size_t n, int min, int max) {
+        if (mode == Mode::FAST) {
+            dist::UniformInt uniform(min, max);
+            for (size_t i = 0; i < n; i++) out[i] = uniform(*this);
+            return;
+        }
+        uint32_t buffer[BATCH_SIZE];
+        auto d = (uint32_t) (max - min);
+        while (n > 0) {
+            size_t count = n < BATCH_SIZE ? n : BATCH_SIZE;
+            fill(buffer, count);
+            size_t i = 0;
+            // The modulo is done in doubles: rounding the quotient can only overshoot by one, which is fixed below
+#if defined(__AVX2__)
+            const __m256d div = _mm256_set1_pd((double) d), inv = _mm256_set1_pd(1.0 / d);
+            const __m256d two31 = _mm256_set1_pd(2147483648.0), two32 = _mm256_set1_pd(4294967296.0);
+            const __m128i base = _mm_set1_epi32(min);
+            for (; i + 4 <= count; i += 4) {
+                __m256d u = toDouble4(buffer + i);
+                __m256d q = _mm256_round_pd(_mm256_mul_pd(u, inv), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                __m256d r = _mm256_sub_pd(u, _mm256_mul_pd(q, div));
+                r = _mm256_add_pd(r, _mm256_and_pd(_mm256_cmp_pd(r, _mm256_setzero_pd(), _CMP_LT_OQ), div));
+                r = _mm256_sub_pd(r, _mm256_and_pd(_mm256_cmp_pd(r, two31, _CMP_GE_OQ), two32));
+                _mm_storeu_si128((__m128i *) (out + i), _mm_add_epi32(_mm256_cvttpd_epi32(r), base));
+            }
+#elif defined(__SSE2__)
+            const __m128d div = _mm_set1_pd((double) d), inv = _mm_set1_pd(1.0 / d);
+            const __m128d two31 = _mm_set1_pd(2147483648.0), two32 = _mm_set1_pd(4294967296.0);
+            const __m128d two52 = _mm_set1_pd(4503599627370496.0);
+            const __m128i base = _mm_set1_epi32(min);
+            for (; i + 4 <= count; i += 4) {
+                __m128i res[2];
+                for (int h = 0; h < 2; h++) {
+                    __m128d u = toDouble2(buffer + i + 2 * h);
+                    __m128d q = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(u, inv), two52), two52);
+                    __m128d r = _mm_sub_pd(u, _mm_mul_pd(q, div));
+                    r = _mm_add_pd(r, _mm_and_pd(_mm_cmplt_pd(r, _mm_setzero_pd()), div));
+                    r = _mm_sub_pd(r, _mm_and_pd(_mm_cmpge_pd(r, two31), two32));
+                    res[h] = _mm_cvttpd_epi32(r);
+                }
+                _mm_storeu_si128((__m128i *) (out + i), _mm_add_epi32(_mm_unpacklo_epi64(res[0], res[1]), base));
+            }
+#endif
+            for (; i < count; i++)
+                out[i] = (int) (buffer[i] % d) + min;
+            out += count;
+            n -= count;
+        }
+    }
+
+    void fillDouble(double *out, size_t n, double min, double max) {
+        if (mode == Mode::FAST) {
+            dist::UniformDouble uniform(min, max);
+            for (size_t i = 0; i < n; i++) out[i] = uniform(*this);
+            return;
+        }
+        uint32_t buffer[BATCH_SIZE];
+        double range = max - min;
+        while (n > 0) {
+            size_t count = n < BATCH_SIZE ? n : BATCH_SIZE;
+            fill(buffer, count);
+            size_t i = 0;
+#if defined(__AVX2__)
+            const __m256d denominator = _mm256_set1_pd((double) (0x7FFFFFFF));
+            const __m256d lo = _mm256_set1_pd(min), hi = _mm256_set1_pd(max), span = _mm256_set1_pd(range);
+            for (; i + 4 <= count; i += 4) {
+                __m256d v = _mm256_add_pd(unfused(_mm256_mul_pd(_mm256_div_pd(toDouble4(buffer + i), denominator), span)), lo);
+                __m256d below = _mm256_cmp_pd(v, lo, _CMP_LT_OQ);
+                __m256d above = _mm256_cmp_pd(v, hi, _CMP_GT_OQ);
+                __m256d res = _mm256_blendv_pd(v, _mm256_sub_pd(v, span), above);
+                _mm256_storeu_pd(out + i, _mm256_blendv_pd(res, _mm256_add_pd(v, span), below));
+            }
+#elif defined(__SSE2__)
+            const __m128d denominator = _mm_set1_pd((double) (0x7FFFFFFF));
+            const __m128d lo = _mm_set1_pd(min), hi = _mm_set1_pd(max), span = _mm_set1_pd(range);
+            for (; i + 2 <= count; i += 2) {
+                __m128d v = _mm_add_pd(unfused(_mm_mul_pd(_mm_div_pd(toDouble2(buffer + i), denominator), span)), lo);
+                __m128d below = _mm_cmplt_pd(v, lo);
+                __m128d above = _mm_andnot_pd(below, _mm_cmpgt_pd(v, hi));
+                __m128d res = _mm_or_pd(_mm_and_pd(above, _mm_sub_pd(v, span)), _mm_and_pd(below, _mm_add_pd(v, span)));
+                _mm_storeu_pd(out + i, _mm_or_pd(res, _mm_andnot_pd(_mm_or_pd(below, above), v)));
+            }
+#endif
+            for (; i < count; i++) {
+                auto res = unfused(((double) buffer[i] / (double) (0x7FFFFFFF)) * range) + min;
+                if (res < min) res += range;
+                else if (res > max) res -= range;
+                out[i] = res;
+            }
+            out += count;
+            n -= count;
+        }
+    }
+
+    void fillBool(bool *out, size_t n) {
+        uint32_t buffer[BATCH_SIZE];
+        while (n > 0) {
+            size_t count = n < BATCH_SIZE ? n : BATCH_SIZE;
+            fill(buffer, count);
+            for (size_t i = 0; i < count; i++)
+                out[i] = buffer[i] & 1;
+            out += count;
+            n -= count;
+        }
+    }
+
+private:
+    // Raw outputs are produced into a small stack buffer first, then converted while still in L1
+    static const size_t BATCH_SIZE = 256;
+
+    // Keeps the compiler from fusing a * b + c into an fma, which would change the low bits of the results
+    // depending on the target and break the scalar / batch equivalence
+    template<typename T>
+    static T unfused(T value) {
+#if defined(__GNUC__) && defined(__SSE2__)
+        __asm__("" : "+x"(value));
+#elif defined(__GNUC__) && defined(__aarch64__)
+        __asm__("" : "+w"(value));
+#endif
+        return value;
+    }
+
+#if defined(__SSE2__)
+    // Both rounds of the hash are a 32x32 -> 64 multiply folded back with hi ^ lo, done for even and odd lanes
+    static __m128i mulFold4(__m128i x, __m128i c) {
+        __m128i even = _mm_mul_epu32(x, c);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), c);
+        even = _mm_xor_si128(even, _mm_srli_epi64(even, 32));
+        odd = _mm_xor_si128(odd, _mm_srli_epi64(odd, 32));
+        return _mm_or_si128(_mm_and_si128(even, _mm_set1_epi64x(0xffffffff)), _mm_slli_epi64(odd, 32));
+    }
+
+    static __m128i hash4(__m128i state) {
+        return mulFold4(mulFold4(state, _mm_set1_epi32(0x4a39b70d)), _mm_set1_epi32(0x12fad5c9));
+    }
+
+    static __m128d toDouble2(const uint32_t *in) {
+        __m128i u = _mm_loadl_epi64((const __m128i *) in);
+        __m128i s = _mm_xor_si128(u, _mm_set1_epi32(INT_MIN));
+        return _mm_add_pd(_mm_cvtepi32_pd(s), _mm_set1_pd(2147483648.0));
+    }
+#endif
+
+#if defined(__AVX2__)
+    static __m256i mulFold8(__m256i x, __m256i c) {
+        __m256i even = _mm256_mul_epu32(x, c);
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), c);
+        even = _mm256_xor_si256(even, _mm256_srli_epi64(even, 32));
+        odd = _mm256_xor_si256(odd, _mm256_srli_epi64(odd, 32));
+        return _mm256_or_si256(_mm256_and_si256(even, _mm256_set1_epi64x(0xffffffff)), _mm256_slli_epi64(odd, 32));
+    }
+
+    static __m256i hash8(__m256i state) {
+        return mulFold8(mulFold8(state, _mm256_set1_epi32(0x4a39b70d)), _mm256_set1_epi32(0x12fad5c9));
+    }
+
+    static __m256d toDouble4(const uint32_t *in) {
+        __m128i u = _mm_loadu_si128((const __m128i *) in);
+        __m128i s = _mm_xor_si128(u, _mm_set1_epi32(INT_MIN));
+        return _mm256_add_pd(_mm256_cvtepi32_pd(s), _mm256_set1_pd(2147483648.0));
+    }
+#endif
+
+#if defined(__AVX512F__)
+    static __m512i mulFold16(__m512i x, __m512i c) {
+        __m512i even = _mm512_mul_epu32(x, c);
+        __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), c);
+        even = _mm512_xor_si512(even, _mm512_srli_epi64(even, 32));
+        odd = _mm512_xor_si512(odd, _mm512_srli_epi64(odd, 32));
+        return _mm512_or_si512(_mm512_and_si512(even, _mm512_set1_epi64(0xffffffff)), _mm512_slli_epi64(odd, 32));
+    }
+
+    static __m512i hash16(__m512i state) {
+        return mulFold16(mulFold16(state, _mm512_set1_epi32(0x4a39b70d)), _mm512_set1_epi32(0x12fad5c9));
+    }
+#endif
+};
+
+// Smoothing stage for height maps. LEGACY reproduces the original in place averaging of getNoiseArray bit for
+// bit, BOX and GAUSSIAN are built on a prefix sum, so their cost per column does not depend on the radius
+class Smoother {
+public:
+    enum class Mode {
+        LEGACY, BOX, GAUSSIAN
+    };
+
+private:
+    Mode mode;
+    // The smooth factor for LEGACY, the radius for BOX and the standard deviation for GAUSSIAN
+    double size;
+    int passes;
+
+public:
+    explicit Smoother(Mode mode = Mode::LEGACY, double size = 8, int passes = 3)
+            : mode(mode), size(size), passes(passes) {}
+
+    [[nodiscard]] Mode getMode() const {
+        return mode;
+    }
+
+    void apply(res::NoiseArray &arr) const {
+        std::vector<double> scratch;
+        apply(arr.data(), arr.size(), scratch);
+    }
+
+    // Scratch is resized as needed, passing the same vector every time avoids reallocating it
+    void apply(double *data, size_t n, std::vector<double> &scratch) const {
+        if (mode == Mode::LEGACY) {
+            applyLegacy(data, n, size);
+        } else if (mode == Mode::BOX) {
+            boxFilter(data, n, (int) size, scratch);
+        } else {
+            for (int i = 0; i < passes; i++)
+                boxFilter(data, n, getGaussianRadius(size, passes, i), scratch);
+        }
+    }
+
+    // Box radius of pass i, so that all passes together have the variance of a gaussian with the given sigma
+    static int getGaussianRadius(double sigma, int passes, int i) {
+        auto wl = (int) std::floor(std::sqrt(12 * sigma * sigma / passes + 1));
+        if (wl % 2 == 0) wl--;
+        int wu = wl + 2;
+        auto m = (int) std::round((12 * sigma * sigma - passes * wl * wl - 4 * passes * wl - 3 * passes) / (-4.0 * wl - 4));
+        return ((i < m ? wl : wu) - 1) / 2;
+    }
+
+    // Averages [j - radius, j + radius], clamped to the array, through prefix sums of the input
+    static void boxFilter(double *data, size_t n, int radius, std::vector<double> &prefix) {
+        if (radius <= 0 || n == 0) return;
+        prefix.resize(n + 1);
+        prefixSum(data, prefix.data(), n);
+        auto r = (size_t) radius;
+        for (size_t j = 0; j < n; j++) {
+            size_t lo = j > r ? j - r : 0;
+            size_t hi = j + r + 1 < n ? j + r + 1 : n;
+            data[j] = (prefix[hi] - prefix[lo]) / (double) (hi - lo);
+        }
+    }
+
+    // out[0] = 0 and out[i + 1] = in[0] + ... + in[i], scanned in registers a vector at a time
+    static void prefixSum(const double *in, double *out, size_t n) {
+        size_t i = 0;
+        out[0] = 0;
+#if defined(__AVX2__)
+        __m256d carry = _mm256_setzero_pd();
+        for (; i + 4 <= n; i += 4) {
+            __m256d x = _mm256_loadu_pd(in + i);
+            x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, 0x90), _mm256_setzero_pd(), 0x1));
+            x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, 0x40), _mm256_setzero_pd(), 0x3));
+            x = _mm256_add_pd(x, carry);
+            _mm256_storeu_pd(out + i + 1, x);
+            carry = _mm256_permute4x64_pd(x, 0xff);
+        }
+#elif defined(__SSE2__)
+        __m128d carry = _mm_setzero_pd();
+        for (; i + 2 <= n; i += 2) {
+            __m128d x = _mm_loadu_pd(in + i);
+            x = _mm_add_pd(x, _mm_unpacklo_pd(_mm_setzero_pd(), x));
+            x = _mm_add_pd(x, carry);
+            _mm_storeu_pd(out + i + 1, x);
+            carry = _mm_unpackhi_pd(x, x);
+        }
+#endif
+        for (; i < n; i++)
+            out[i + 1] = out[i] + in[i];
+    }
+
+    // The original smoothing of getNoiseArray, kept as it was. It reads the columns it has already overwritten
+    // and skips index 0 on the left, and the worlds of existing seeds depend on exactly that
+    static void applyLegacy(double *noiseArr, size_t size, const double SMOOTH_FACTOR) {
+        for (size_t j = 0; j < size; j++)
+            applyLegacy(noiseArr, size, j, SMOOTH_FACTOR);
+    }
+
+    // Smooths column j alone. Only columns up to j + getLegacyLookahead() have to exist, which lets the
+    // generation pipeline smooth right behind the random walk
+    static void applyLegacy(double *noiseArr, size_t size, size_t j, const double SMOOTH_FACTOR) {
+        double avg = 0;
+        int c = 0;
+        for (int k = 0; k < SMOOTH_FACTOR && (j - k) > 0; k++, c++)
+            avg += noiseArr[j - k];
+        for (int k = -5; k < SMOOTH_FACTOR && (j + k) < size && (j + k) >= 0; k++, c++)
+            avg += noiseArr[j + k];
+        if (c)
+            avg /= c;
+        else
+            return;
+        noiseArr[j] = avg;
+    }
+
+    // At least one column, even when the smoothing itself reads none ahead: the random walk goes on from the
+    // unsmoothed previous column, so that one has to stay as it is until the next column exists
+    static size_t getLegacyLookahead(const double SMOOTH_FACTOR) {
+        return SMOOTH_FACTOR > 1 ? (size_t) std::ceil(SMOOTH_FACTOR) - 1 : 1;
+    }
+};
+
+// Runs the tasks 0 to n - 1 on a fixed set of threads, the calling thread included. Every thread starts on its own
+// share of the tasks and then steals from the shares of the others, so slow tasks do not hold up the rest
+class TilePool {
+public:
+    explicit TilePool(unsigned nThreads) : shares(std::max(1u, nThreads)) {
+        for (unsigned i = 1; i < shares.size(); i++)
+            workers.emplace_back(&TilePool::workerLoop, this, i);
+    }
+
+    ~TilePool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        start.notify_all();
+        for (auto &worker: workers)
+            worker.join();
+    }
+
+    TilePool(const TilePool &) = delete;
+
+    TilePool &operator=(const TilePool &) = delete;
+
+    [[nodiscard]] size_t size() const {
+        return shares.size();
+    }
+
+    // Calls task(i) once for every i in [0, n) and returns once all of them are done
+    template<typename Task>
+    void run(int n, Task &task) {
+        for (size_t s = 0; s < shares.size(); s++) {
+            shares[s].next = (int) (n * s / shares.size());
+            shares[s].end = (int) (n * (s + 1) / shares.size());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            taskContext = &task;
+            taskFunction = [](void *context, int i) { (*static_cast<Task *>(context))(i); };
+            busy = workers.size();
+            generation++;
+        }
+        start.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return busy == 0; });
+    }
+
+private:
+    // Kept on separate cache lines, the counters are hammered by their owner
+    struct alignas(64) Share {
+        std::atomic<int> next{0};
+        int end = 0;
+    };
+
+    std::vector<Share> shares;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+    void (*taskFunction)(void *, int) = nullptr;
+    void *taskContext = nullptr;
+    size_t busy = 0;
+    uint64_t generation = 0;
+    bool stop = false;
+
+    void work(size_t self) {
+        for (size_t k = 0; k < shares.size(); k++) {
+            Share &share = shares[(self + k) % shares.size()];
+            for (int i = share.next++; i < share.end; i = share.next++)
+                taskFunction(taskContext, i);
+        }
+    }
+
+    void workerLoop(size_t self) {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start.wait(lock, [&] { return stop || generation != seen; });
+                if (stop) return;
+                seen = generation;
+            }
+
+            work(self);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) done.notify_one();
+        }
+    }
+};
+
+// Shapes rasterised once into sprites that are transparent around the shape, found again by a description of the
+// shape. Once the sprites add up to more pixels than the budget, the least recently used are dropped, except those
+// looked up since the last beginFrame() - they may still be drawn
+class SpriteCache {
+public:
+    // A rasterised shape, its top left corner is offset from the position the shape is drawn at. Only the columns
+    // [rowBegin[y], rowEnd[y]) of row y hold any of the shape
+    struct Shape {
+        std::unique_ptr<olc::Sprite> sprite;
+        olc::vi2d offset;
+        std::vector<int32_t> rowBegin;
+        std::vector<int32_t> rowEnd;
+    };
+
+    explicit SpriteCache(size_t maxPixels) : maxPixels(maxPixels) {}
+
+    SpriteCache(const SpriteCache &) = delete;
+
+    SpriteCache &operator=(const SpriteCache &) = delete;
+
+    void beginFrame() {
+        frame++;
+    }
+
+    // The shape described by key. A new one is size pixels large, and draw(canvas, origin) draws it with the drawing
+    // position at origin. The shape stays valid at least until the next beginFrame()
+    template<typename Draw>
+    const Shape &get(const std::vector<int32_t> &key, olc::vi2d offset, olc::vi2d size, Draw draw) {
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            order.splice(order.begin(), order, it->second.use);
+            it->second.frame = frame;
+            return it->second.shape;
+        }
+
+        it = entries.try_emplace(key).first;
+        Entry &entry = it->second;
+        entry.shape.sprite = std::make_unique<olc::Sprite>(size.x, size.y);
+        entry.shape.offset = offset;
+        entry.frame = frame;
+        order.push_front(&it->first);
+        entry.use = order.begin();
+        pixels += (size_t) size.x * size.y;
+
+        olc::DrawContext canvas(entry.shape.sprite.get());
+        canvas.Clear(olc::BLANK);
+        draw(canvas, olc::vi2d(-offset.x, -offset.y));
+        trimRows(entry.shape);
+
+        // Shapes handed out this frame are still in use, so they are never evicted
+        while (pixels > maxPixels && entries.at(*order.back()).frame != frame)
+            erase(entries.find(*order.back()));
+        return entry.shape;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return entries.size();
+    }
+
+    [[nodiscard]] size_t pixelCount() const {
+        return pixels;
+    }
+
+private:
+    struct Entry {
+        Shape shape;
+        uint64_t frame = 0;
+        std::list<const std::vector<int32_t> *>::iterator use;
+    };
+
+    struct KeyHash {
+        size_t operator()(const std::vector<int32_t> &key) const {
+            uint64_t h = 1469598103934665603ull;
+            for (auto k: key) {
+                h ^= (uint32_t) k;
+                h *= 1099511628211ull;
+            }
+            return (size_t) h;
+        }
+    };
+
+    size_t maxPixels;
+    size_t pixels = 0;
+    uint64_t frame = 0;
+    // Keyed by the whole key, so shapes that only share a hash are both kept
+    std::unordered_map<std::vector<int32_t>, Entry, KeyHash> entries;
+    // Keys of the entries, the most recently used first. The map never moves its elements
+    std::list<const std::vector<int32_t> *> order;
+
+    static void trimRows(Shape &shape) {
+        const olc::Sprite &sprite = *shape.sprite;
+        shape.rowBegin.assign(sprite.height, 0);
+        shape.rowEnd.assign(sprite.height, 0);
+        for (int y = 0; y < sprite.height; y++) {
+            const olc::Pixel *row = sprite.pColData.data() + (size_t) y * sprite.width;
+            int begin = 0, end = sprite.width;
+            while (begin < end && row[begin].a == 0) begin++;
+            while (end > begin && row[end - 1].a == 0) end--;
+            shape.rowBegin[y] = begin;
+            shape.rowEnd[y] = end;
+        }
+    }
+
+    void erase(std::unordered_map<std::vector<int32_t>, Entry, KeyHash>::iterator it) {
+        pixels -= (size_t) it->second.shape.sprite->width * it->second.shape.sprite->height;
+        order.erase(it->second.use);
+        entries.erase(it);
+    }
 };
 
 class World : public olc::PixelGameEngine {
 
     uint32_t seed = 0;
-    res::NoiseArray noiseArray;
-    res::TreeList treeList;
-    res::CloudList cloudList;
 
     static const int UPPER_BOUND = 200;
     static const int LOWER_BOUND = 800;
@@ -147,243 +1191,716 @@ class World : public olc::PixelGameEngine {
     static const int X_CLOUD_PARTICLE_RANGE = 45;
     static const int Y_CLOUD_PARTICLE_RANGE = 12;
 
-    double minLandHeight{};
-    double maxLandHeight{};
-    double avgLandHeight{};
+    // The box a cloud fits in, most of its rows are a single run
+    static const int CLOUD_COLUMNS_MAX = 2 * (X_CLOUD_PARTICLE_RANGE + CLOUD_PART_RADIUS_MAX) + 1;
+    static const int CLOUD_ROWS_MAX = 2 * (Y_CLOUD_PARTICLE_RANGE + CLOUD_PART_RADIUS_MAX) + 1;
 
-    int waterBoundHeight{};
+    // Columns of the single screen world that are generated, smoothed and measured in one go
+    static const size_t GEN_BLOCK_SIZE = 512;
+
+    static const int CHUNK_WIDTH = 256;
+    static const int CHUNK_SMOOTH_RADIUS = 15;
+
+    static const int CHUNK_ANCHOR_MIN = 300;
+    static const int CHUNK_ANCHOR_MAX = 700;
+    static const int CHUNK_ANCHOR_JITTER = 30;
+    // Number of chunk edges covered by one cell of the coarse anchor noise
+    static const int CHUNK_ANCHOR_SPAN = 4;
+
+    static const int CHUNK_SCROLL_SPEED = 600;
+
+    static const int SCENE_TILE_SIZE = 128;
+    // Pixels of tree sprites kept around, about 400 shapes
+    static const size_t SHAPE_CACHE_PIXELS = 1 << 21;
+
+    // Salts keep the random streams of a chunk independent of each other
+    static const uint32_t SALT_ANCHOR = 0x1b873593;
+    static const uint32_t SALT_JITTER = 0x68e31da4;
+    static const uint32_t SALT_TERRAIN = 0xb5297a4d;
+    static const uint32_t SALT_DECORATION = 0x1b56c4e9;
+
+    Smoother::Mode smoothingMode = Smoother::Mode::LEGACY;
+
+    bool chunkedTerrain = false;
+    double cameraX = 0;
+
+    // A request for the generator thread, a newer request replaces a pending one
+    struct GenerationJob {
+        uint32_t seed;
+        bool chunked;
+        double cameraX;
+        Smoother::Mode smoothingMode;
+        // Holding C only regenerates the land and the trees, the clouds stay as they are
+        bool keepClouds;
+    };
+
+    // The renderer only ever reads the front world, the generator thread only ever writes the back world
+    std::unique_ptr<res::WorldState> frontWorld = std::make_unique<res::WorldState>();
+    std::unique_ptr<res::WorldState> backWorld = std::make_unique<res::WorldState>();
+
+    std::thread generatorThread;
+    std::mutex generatorMutex;
+    std::condition_variable generatorSignal;
+    GenerationJob pendingJob{};
+    bool hasPendingJob = false;
+    bool stopGenerator = false;
+    std::atomic<bool> backWorldReady{false};
+
+    // The world is rendered into this sprite once per generated world, frames in between only copy it, if at all
+    std::unique_ptr<olc::Sprite> scene;
+    bool sceneDirty = true;
+    // The draw target the scene was last copied to. Nothing else draws to it, so while it is still the draw target
+    // it still holds the scene
+    olc::Sprite *presentedTarget = nullptr;
+
+    // The scene is cut into tiles rendered on every core, P switches to one tile rendered on the engine thread
+    bool parallelScene = true;
+    std::unique_ptr<TilePool> scenePool;
+
+    // The trees and clouds that overlap a scene tile, in drawing order
+    struct SceneBin {
+        std::vector<uint32_t> trees;
+        std::vector<uint32_t> clouds;
+    };
+    std::vector<SceneBin> sceneBins;
+
+    // Trees are drawn as sprites, shapes that come up again, such as when scrolling, are not rasterised again.
+    // Looked up on the engine thread, the tiles only read the shapes of the scene being rendered
+    SpriteCache shapeCache{SHAPE_CACHE_PIXELS};
+    std::vector<const SpriteCache::Shape *> treeShapes;
+    std::vector<int32_t> shapeKey;
+
+    // Buffers the generator reuses from one world to the next
+    struct WorldGenContext {
+        std::vector<double> smoothScratch;
+    };
+
+    // Only touched by the generator thread
+    WorldGenContext genContext;
+    res::ChunkCache chunkCache;
+    uint32_t chunkCacheSeed = 0;
 
 public:
     World() {
         sAppName = "2D World Generation";
     }
 
+    ~World() override {
+        stopGeneratorThread();
+    }
+
     bool OnUserCreate() override {
-        // On create, create the noise array
-        Lehmer32 rnd(seed);
-        noiseArray = getNoiseArray(ScreenWidth(), rnd, 100, ScreenHeight() - 100, 2, 30);
-        for (auto &tree: treeList)
-            delete tree;
-        for (auto &cloud: cloudList)
-        delete cloud;
-        ResourceContainer resources;
-        treeList = getTreeList(TREE_FREQ, noiseArray, resources, rnd);
-        cloudList = getCloudList(CLOUD_FREQ, resources, rnd);
+        // Trees and clouds are at least half their frequency apart, the chunked view spans the screen plus a margin
+        size_t nChunks = ScreenWidth() / CHUNK_WIDTH + 3;
+        size_t maxTrees = nChunks * (CHUNK_WIDTH / (TREE_FREQ / 2) + 1);
+        size_t maxClouds = nChunks * (CHUNK_WIDTH / (CLOUD_FREQ / 2) + 1);
+        for (auto world: {frontWorld.get(), backWorld.get()})
+            world->reserve(ScreenWidth(), maxTrees, maxClouds, maxClouds * CLOUD_ROWS_MAX * 2, N_CLOUD_PARTICLES_MAX,
+                           CLOUD_COLUMNS_MAX * CLOUD_ROWS_MAX);
+        genContext.smoothScratch.reserve(ScreenWidth() + 1);
+        scenePool = std::make_unique<TilePool>(std::thread::hardware_concurrency());
+
+        // On create, create the first world right away, later ones are made by the generator thread
+        generateWorld(*frontWorld, {seed, chunkedTerrain, cameraX, smoothingMode, false});
+        generatorThread = std::thread(&World::generatorLoop, this);
+
+        SetIdleMode(IDLE);
+        SetFrameRateLimit(FRAME_RATE_LIMIT);
+        return true;
+    }
+
+    bool OnUserDestroy() override {
+        stopGeneratorThread();
         return true;
     }
 
     bool OnUserUpdate(float fElapsedTime) override {
-        Clear(olc::BLACK);
+        // If k is pressed, switch between the single screen world and the endless chunked world
+        if (GetKey(olc::K).bPressed) {
+            chunkedTerrain = !chunkedTerrain;
+            cameraX = 0;
+            requestWorld();
+        }
 
-        ResourceContainer resources;
+        // If s is pressed, cycle through the smoothing modes and rebuild the current world with it
+        if (GetKey(olc::S).bPressed && !chunkedTerrain) {
+            if (smoothingMode == Smoother::Mode::LEGACY) smoothingMode = Smoother::Mode::BOX;
+            else if (smoothingMode == Smoother::Mode::BOX) smoothingMode = Smoother::Mode::GAUSSIAN;
+            else smoothingMode = Smoother::Mode::LEGACY;
+            requestWorld();
+        }
 
         // If space is pressed, generate a new seed and regenerate the noise array
         if (GetKey(olc::SPACE).bPressed) {
             // Picks a seed based on time
             seed = std::chrono::system_clock::now().time_since_epoch().count();
-            Lehmer32 rnd(seed);
-            noiseArray = getNoiseArray(ScreenWidth(), rnd, 100, ScreenHeight() - 100, 2, 30);
-            for (auto &tree: treeList)
-                delete tree;
-            for (auto &cloud: cloudList)
-                delete cloud;
-            treeList = getTreeList(TREE_FREQ, noiseArray, resources, rnd);
-            cloudList = getCloudList(CLOUD_FREQ, resources, rnd);
+            requestWorld();
         }
 
         // If c is held, generate a new seed and regenerate the noise array repeatedly
         if (GetKey(olc::C).bHeld) {
             seed = std::chrono::system_clock::now().time_since_epoch().count();
-            Lehmer32 rnd(seed);
-            noiseArray = getNoiseArray(ScreenWidth(), rnd, 100, ScreenHeight() - 100, 2, 30);
-            for (auto &tree: treeList)
-                delete tree;
-            treeList = getTreeList(TREE_FREQ, noiseArray, resources, rnd);
-        }
-
-        // Draw the sky
-        for (int i = 0; i < noiseArray.size(); i++) {
-            for (int j = 0; j < noiseArray[i]; j++) {
-                olc::Pixel pixel{0xffc5b576};
-                Draw(i, j, pixel);
+            requestWorld(true);
+            RequestRedraw();
+        }
+
+        // Arrows scroll through the chunked world, only the visible chunks are kept around
+        if (chunkedTerrain && (GetKey(olc::LEFT).bHeld || GetKey(olc::RIGHT).bHeld)) {
+            if (GetKey(olc::LEFT).bHeld) cameraX -= CHUNK_SCROLL_SPEED * fElapsedTime;
+            if (GetKey(olc::RIGHT).bHeld) cameraX += CHUNK_SCROLL_SPEED * fElapsedTime;
+            requestWorld();
+            RequestRedraw();
+        }
+
+        // If p is pressed, switch between rendering the scene in parallel tiles and in one go
+        if (GetKey(olc::P).bPressed) {
+            parallelScene = !parallelScene;
+            invalidateScene();
+        }
+
+        // Pick up the world the generator has finished, if there is one - the frame never waits for it
+        if (backWorldReady) {
+            std::lock_guard<std::mutex> lock(generatorMutex);
+            std::swap(frontWorld, backWorld);
+            backWorldReady = false;
+            generatorSignal.notify_one();
+            // Shows up in the window title next to the FPS
+            sAppName = "2D World Generation - allocations: " + std::to_string(frontWorld->allocations);
+            invalidateScene();
+        }
+
+        if (sceneDirty) renderScene(*frontWorld);
+        presentScene();
+
+        return true;
+    }
+
+    // Marks the cached scene as stale, it is rendered again on the next frame
+    void invalidateScene() {
+        sceneDirty = true;
+    }
+
+    // Renders the whole world into the scene sprite
+    void renderScene(const res::WorldState &world) {
+        if (!scene || scene->width != ScreenWidth() || scene->height != ScreenHeight())
+            scene = std::make_unique<olc::Sprite>(ScreenWidth(), ScreenHeight());
+
+        const ResourceContainer resources;
+
+        // Every tile draws all passes in the serial order, so the tiles add up to exactly the serial scene
+        int tileWidth = parallelScene ? SCENE_TILE_SIZE : ScreenWidth();
+        int tileHeight = parallelScene ? SCENE_TILE_SIZE : ScreenHeight();
+        int tilesX = (ScreenWidth() + tileWidth - 1) / tileWidth;
+        int tilesY = (ScreenHeight() + tileHeight - 1) / tileHeight;
+        binScene(world, tileWidth, tileHeight, tilesX, tilesY, resources);
+
+        auto renderTile = [&](int tile) {
+            int left = tile % tilesX * tileWidth;
+            int top = tile / tilesX * tileHeight;
+            // Contexts carry their own clip, so the tiles can be drawn from any thread
+            olc::DrawContext canvas = olc::DrawContext(scene.get()).Clip(left, top, tileWidth, tileHeight);
+            renderSceneTile(world, canvas, sceneBins[tile], resources);
+        };
+        if (parallelScene)
+            scenePool->run(tilesX * tilesY, renderTile);
+        else
+            renderTile(0);
+
+        // Post-processing
+        for (int i = 0; i < ScreenWidth(); i++) {
+            int y = (int) world.noiseArray[i];
+            if (y > world.waterBoundHeight - 5 && y < world.waterBoundHeight + 5) {
+                // TODO: Smooth out the terrain transition
             }
         }
 
+        sceneDirty = false;
+        presentedTarget = nullptr;
+    }
+
+    void renderSceneTile(const res::WorldState &world, const olc::DrawContext &canvas, const SceneBin &bin,
+                         const ResourceContainer &resources) {
+        canvas.Clear(olc::BLACK);
+        int minX = canvas.GetClipPos().x;
+        int maxX = minX + canvas.GetClipSize().x - 1;
+
+        // Draw the sky, one span from the top of every column down to the land
+        for (int i = minX; i <= maxX; i++)
+            canvas.FillSpanV(i, 0, (int) std::ceil(world.noiseArray[i]) - 1, olc::Pixel{0xffc5b576});
+
         // Draw the trees
-        for (const auto &tree: treeList)
-            drawTree(tree);
+        for (auto i: bin.trees)
+            drawShape(canvas, *treeShapes[i], world.treeList.x[i], world.treeList.y[i]);
 
         // Draw the noise array - this is the ground
-        for (int i = 0; i < noiseArray.size(); i++) {
-            auto sub1 = ScreenHeight() - noiseArray[i];
-            bool isWater = (noiseArray[i]) > waterBoundHeight;
-            for (int j = 0; j <= ScreenHeight() - noiseArray[i]; j++) {
-                int index;
-                double percentage = (double) j / (double) sub1;
-                if (percentage > 0.4) index = 0;
-                else index = 1;
-                if (j > 12 && j < 45) {
-                    if (isWater) index = 4;
-                    else index = 2;
-                } else if (j <= 12) {
-                    if (isWater) index = 5;
-                    else index = 3;
-                }
-                olc::Pixel pixel{resources.getEarthColor(index)};
-                Draw(i, (int) noiseArray[i] + j, pixel);
-            }
+        for (int i = minX; i <= maxX; i++)
+            drawGroundColumn(canvas, i, world.noiseArray[i], world.noiseArray[i] > world.waterBoundHeight, resources);
+
+        // Draw the water, the span is empty wherever the land is above the water level
+        for (int i = minX; i <= maxX; i++)
+            canvas.FillSpanV(i, world.waterBoundHeight, (int) std::ceil(world.noiseArray[i]) - 1,
+                             olc::Pixel{resources.getWaterColor()});
+
+        // Draw the clouds
+        for (auto i: bin.clouds)
+            drawCloud(canvas, world.cloudList, i, resources);
+    }
+
+    // Looks up the shapes of the trees and sorts the trees and clouds into the tiles they overlap
+    void binScene(const res::WorldState &world, int tileWidth, int tileHeight, int tilesX, int tilesY,
+                  const ResourceContainer &resources) {
+        sceneBins.resize(tilesX * tilesY);
+        for (auto &bin: sceneBins) {
+            bin.trees.clear();
+            bin.clouds.clear();
         }
 
-        // Draw the water
-        for (int i = 0; i < ScreenWidth(); i++) {
-            if (noiseArray[i] > waterBoundHeight) {
-                for (int j = waterBoundHeight; j < noiseArray[i]; j++) {
-                    olc::Pixel pixel{resources.getWaterColor()};
-                    Draw(i, j, pixel);
-                }
+        auto add = [&](int left, int top, int right, int bottom, std::vector<uint32_t> SceneBin::*list, size_t i) {
+            if (right < 0 || bottom < 0 || left >= ScreenWidth() || top >= ScreenHeight()) return;
+            for (int ty = std::max(top, 0) / tileHeight; ty <= std::min(bottom, ScreenHeight() - 1) / tileHeight; ty++)
+                for (int tx = std::max(left, 0) / tileWidth; tx <= std::min(right, ScreenWidth() - 1) / tileWidth; tx++)
+                    (sceneBins[ty * tilesX + tx].*list).push_back((uint32_t) i);
+        };
+
+        auto addShape = [&](const SpriteCache::Shape &shape, int x, int y, std::vector<uint32_t> SceneBin::*list,
+                            size_t i) {
+            int left = x + shape.offset.x;
+            int top = y + shape.offset.y;
+            add(left, top, left + shape.sprite->width - 1, top + shape.sprite->height - 1, list, i);
+        };
+
+        shapeCache.beginFrame();
+
+        const res::TreeList &trees = world.treeList;
+        treeShapes.resize(trees.size());
+        for (size_t i = 0; i < trees.size(); i++) {
+            treeShapes[i] = &getTreeShape(trees, i, resources);
+            addShape(*treeShapes[i], trees.x[i], trees.y[i], &SceneBin::trees, i);
+        }
+
+        const res::CloudList &clouds = world.cloudList;
+        for (size_t i = 0; i < clouds.size(); i++) {
+            if (clouds.runBegin[i] == clouds.runEnd(i)) continue;
+            int left = INT_MAX, right = INT_MIN;
+            for (size_t k = clouds.runBegin[i]; k < clouds.runEnd(i); k++) {
+                left = std::min(left, (int) clouds.runX[k]);
+                right = std::max(right, clouds.runX[k] + clouds.runLength[k] - 1);
             }
+            add(clouds.x[i] + left, clouds.y[i] + clouds.runY[clouds.runBegin[i]], clouds.x[i] + right,
+                clouds.y[i] + clouds.runY[clouds.runEnd(i) - 1], &SceneBin::clouds, i);
+        }
+    }
+
+    // The tree as a sprite, drawn at the foot of its trunk
+    const SpriteCache::Shape &getTreeShape(const res::TreeList &trees, size_t i, const ResourceContainer &resources) {
+        int w = trees.width[i], h = trees.height[i], r = trees.radius[i];
+        int trunkTop = TREE_BARK_HIDE_OFFSET - h;
+        int crownX = w / 2;
+        int crownY = trunkTop - r / 2;
+        int left = std::min(0, crownX - r), top = std::min(trunkTop, crownY - r);
+        int right = std::max(w - 1, crownX + r), bottom = std::max(trunkTop + h - 1, crownY + r);
+
+        shapeKey.assign({w, h, r, trees.barkColor[i], trees.leafColor[i]});
+        olc::Pixel bark = resources.getTreeColor(trees.barkColor[i]);
+        olc::Pixel leaf = resources.getTreeColor(trees.leafColor[i]);
+        return shapeCache.get(shapeKey, {left, top}, {right - left + 1, bottom - top + 1},
+                              [&](const olc::DrawContext &canvas, olc::vi2d origin) {
+                                  canvas.FillRect(origin.x, origin.y + trunkTop, w, h, bark);
+                                  canvas.FillCircle(origin.x + crownX, origin.y + crownY, r, leaf);
+                              });
+    }
+
+    // Every pixel of the cloud is written once, run by run
+    static void drawCloud(const olc::DrawContext &canvas, const res::CloudList &clouds, size_t i,
+                          const ResourceContainer &resources) {
+        for (size_t k = clouds.runBegin[i]; k < clouds.runEnd(i); k++) {
+            int left = clouds.x[i] + clouds.runX[k];
+            canvas.FillSpanH(left, left + clouds.runLength[k] - 1, clouds.y[i] + clouds.runY[k],
+                             resources.getCloudColor(clouds.runColor[k]));
         }
+    }
 
-        // Draw the clouds
-        for (const auto &cloud: cloudList)
-            drawCloud(cloud);
+    // A masked blit of the rows of the shape, the tile clips them
+    static void drawShape(const olc::DrawContext &canvas, const SpriteCache::Shape &shape, int x, int y) {
+        const olc::Sprite &sprite = *shape.sprite;
+        int left = x + shape.offset.x;
+        int top = y + shape.offset.y;
+        int firstRow = std::max(0, canvas.GetClipPos().y - top);
+        int lastRow = std::min(sprite.height, canvas.GetClipPos().y + canvas.GetClipSize().y - top);
+        for (int row = firstRow; row < lastRow; row++)
+            canvas.DrawSpan(olc::blend::Mask(), left + shape.rowBegin[row], top + row,
+                            sprite.pColData.data() + (size_t) row * sprite.width + shape.rowBegin[row],
+                            shape.rowEnd[row] - shape.rowBegin[row]);
+    }
 
-        // Post-processing
-        for (int i = 0; i < ScreenWidth(); i++) {
-            int y = (int) noiseArray[i];
-            if (y > waterBoundHeight - 5 && y < waterBoundHeight + 5) {
-                // TODO: Smooth out the terrain transition
+    // Copies the scene to the draw target, unless the draw target still holds it from an earlier frame
+    void presentScene() {
+        olc::Sprite *target = GetDrawTarget();
+        if (target == presentedTarget) return;
+        if (target->width == scene->width && target->height == scene->height) {
+            std::copy(scene->pColData.begin(), scene->pColData.end(), target->pColData.begin());
+            target->SetDirty();
+        } else
+            DrawSprite(0, 0, scene.get());
+        presentedTarget = target;
+    }
+
+    // Queues a new world with the current settings, requests made while the generator is busy are coalesced
+    void requestWorld(bool keepClouds = false) {
+        std::lock_guard<std::mutex> lock(generatorMutex);
+        if (hasPendingJob) keepClouds = keepClouds && pendingJob.keepClouds;
+        pendingJob = {seed, chunkedTerrain, cameraX, smoothingMode, keepClouds};
+        hasPendingJob = true;
+        generatorSignal.notify_one();
+    }
+
+    void generatorLoop() {
+        std::unique_lock<std::mutex> lock(generatorMutex);
+        while (true) {
+            // A finished back world has to be picked up by the renderer before it can be overwritten
+            generatorSignal.wait(lock, [&] { return stopGenerator || (hasPendingJob && !backWorldReady); });
+            if (stopGenerator) return;
+            GenerationJob job = pendingJob;
+            hasPendingJob = false;
+            lock.unlock();
+
+            size_t allocationsBefore = allocationCount;
+            generateWorld(*backWorld, job);
+            backWorld->allocations = allocationCount - allocationsBefore;
+
+            lock.lock();
+            backWorldReady = true;
+            RequestRedraw();
+        }
+    }
+
+    void stopGeneratorThread() {
+        if (!generatorThread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(generatorMutex);
+            stopGenerator = true;
+        }
+        generatorSignal.notify_one();
+        generatorThread.join();
+    }
+
+    void generateWorld(res::WorldState &world, const GenerationJob &job) {
+        world.seed = job.seed;
+        world.clear();
+
+        if (job.chunked) {
+            if (job.seed != chunkCacheSeed) {
+                chunkCache.clear();
+                chunkCacheSeed = job.seed;
             }
+            buildChunkView(world, job.cameraX);
+            return;
         }
 
-        return true;
+        Lehmer32 rnd(job.seed);
+        getNoiseArray(world, genContext, job.smoothingMode, ScreenWidth(), rnd, 100, ScreenHeight() - 100, 2, 30);
+        getTreeList(TREE_FREQ, world, rnd);
+        // The front world is only read here, and the renderer does not swap it while a job runs
+        if (job.keepClouds)
+            world.copyClouds(*frontWorld);
+        else
+            getCloudList(CLOUD_FREQ, world, rnd);
     }
 
-    res::NoiseArray
-    getNoiseArray(size_t size, Lehmer32 &lehmer, const int startRangeFrom, const int startRangeTo, const int range = 2,
+    // Fills world.noiseArray, reusing its storage and the scratch of the context
+    void
+    getNoiseArray(res::WorldState &world, WorldGenContext &context, Smoother::Mode smoothingMode, size_t size,
+                  Lehmer32 &lehmer, const int startRangeFrom, const int startRangeTo, const int range = 2,
                   const double SMOOTH_FACTOR = 8, const double VEL_RATIO = -1.0) {
 
-        res::NoiseArray noiseArr(size);
+        res::NoiseArray &noiseArr = world.noiseArray;
+        noiseArr.resize(size);
         noiseArr[0] = lehmer.rndInt(startRangeFrom, startRangeTo);
 
         double vel = 0;
 
-        // Create the noise array
-        for (size_t i = 1; i < size; i++) {
-            auto from = noiseArr[i - 1] - range;
-            auto to = noiseArr[i - 1] + range;
-            noiseArr[i] = lehmer.rndDouble(from - vel, to + vel);
+        res::HeightStats stats(ScreenHeight(), 0);
+
+        // The legacy smoothing only looks a few columns ahead, so walk, smoothing and statistics are done block by
+        // block while the block is still in cache. The other smoothing modes need the whole walk first
+        bool fused = smoothingMode == Smoother::Mode::LEGACY;
+        size_t lookahead = Smoother::getLegacyLookahead(SMOOTH_FACTOR);
+        size_t done = 0;
+
+        for (size_t block = 0; block < size; block += GEN_BLOCK_SIZE) {
+            size_t end = std::min(size, block + GEN_BLOCK_SIZE);
+
+            // Create the noise array
+            for (size_t i = std::max(block, (size_t) 1); i < end; i++) {
+                auto from = noiseArr[i - 1] - range;
+                auto to = noiseArr[i - 1] + range;
+                noiseArr[i] = lehmer.rndDouble(from - vel, to + vel);
+
+                // Bounds check
+                if (noiseArr[i] < UPPER_BOUND) noiseArr[i] = lehmer.rndDouble(UPPER_BOUND, UPPER_BOUND + range);
+                else if (noiseArr[i] > LOWER_BOUND)
+                    noiseArr[i] = lehmer.rndDouble(LOWER_BOUND - range, LOWER_BOUND);
+
+                // Velocity change
+                auto acc = lehmer.rndDouble(-vel * 0.1, vel * 0.1) + vel;
+                vel += acc;
+                if (vel > range / (VEL_RATIO / 2)) vel = range / (VEL_RATIO / 3);
+                if (vel < -range / (VEL_RATIO / 2)) vel = -range / (VEL_RATIO / 3);
+            }
 
-            // Bounds check
-            if (noiseArr[i] < UPPER_BOUND) noiseArr[i] = lehmer.rndDouble(UPPER_BOUND, UPPER_BOUND + range);
-            else if (noiseArr[i] > LOWER_BOUND)
-                noiseArr[i] = lehmer.rndDouble(LOWER_BOUND - range, LOWER_BOUND);
+            if (!fused) continue;
 
-            // Velocity change
-            auto acc = lehmer.rndDouble(-vel * 0.1, vel * 0.1) + vel;
-            vel += acc;
-            if (vel > range / (VEL_RATIO / 2)) vel = range / (VEL_RATIO / 3);
-            if (vel < -range / (VEL_RATIO / 2)) vel = -range / (VEL_RATIO / 3);
+            // Smooth out the terrain, as far as the walk allows, and gather the statistics of the final columns
+            size_t ready = end == size ? size : (end > lookahead ? end - lookahead : 0);
+            for (; done < ready; done++) {
+                Smoother::applyLegacy(noiseArr.data(), size, done, SMOOTH_FACTOR);
+                stats.add(noiseArr[done]);
+            }
         }
 
-        // Smooth out the terrain - this is a bit slow, but it works
-        for (size_t j = 0; j < size; j++) {
-            double avg = 0;
-            int c = 0;
-            for (int k = 0; k < SMOOTH_FACTOR && (j - k) > 0; k++, c++)
-                avg += noiseArr[j - k];
-            for (int k = -5; k < SMOOTH_FACTOR && (j + k) < size && (j + k) >= 0; k++, c++)
-                avg += noiseArr[j + k];
-            if (c)
-                avg /= c;
-            else
-                continue;
-            noiseArr[j] = avg;
+        if (!fused) {
+            Smoother(smoothingMode, SMOOTH_FACTOR / 2).apply(noiseArr.data(), size, context.smoothScratch);
+            for (size_t i = 0; i < size; i++)
+                stats.add(noiseArr[i]);
         }
 
-        avgLandHeight = 0;
-        minLandHeight = ScreenHeight();
-        maxLandHeight = 0;
+        world.minLandHeight = stats.min;
+        world.maxLandHeight = stats.max;
+        world.avgLandHeight = stats.avg();
+
+        world.waterBoundHeight = (int) ((2 * world.avgLandHeight + world.maxLandHeight) / 3);
+    }
+
+    static int64_t floorDiv(int64_t a, int64_t b) {
+        return a / b - (a % b != 0 && (a < 0) != (b < 0));
+    }
+
+    // Every random stream of the chunked world is keyed by (seed, index), so chunks can be generated in any order.
+    // The chunked world has no old seeds to reproduce, so it uses the fast distributions
+    static Lehmer32 getChunkStream(uint32_t seed, int64_t index, uint32_t salt) {
+        Lehmer32 rnd(seed, Lehmer32::Mode::FAST);
+        return rnd.split(salt).split((uint32_t) index).split((uint32_t) ((uint64_t) index >> 32));
+    }
+
+    // Height of the seam between chunk edge - 1 and chunk edge: coarse value noise plus a bit of jitter
+    static double getChunkAnchor(uint32_t seed, int64_t edge) {
+        int64_t cell = floorDiv(edge, CHUNK_ANCHOR_SPAN);
+        double t = (double) (edge - cell * CHUNK_ANCHOR_SPAN) / CHUNK_ANCHOR_SPAN;
+        Lehmer32 from = getChunkStream(seed, cell, SALT_ANCHOR);
+        Lehmer32 to = getChunkStream(seed, cell + 1, SALT_ANCHOR);
+        Lehmer32 jitter = getChunkStream(seed, edge, SALT_JITTER);
+        double a = from.rndDouble(CHUNK_ANCHOR_MIN, CHUNK_ANCHOR_MAX);
+        double b = to.rndDouble(CHUNK_ANCHOR_MIN, CHUNK_ANCHOR_MAX);
+        double s = (1 - std::cos(t * 3.14159265358979323846)) / 2;
+        return a + (b - a) * s + jitter.rndDouble(-CHUNK_ANCHOR_JITTER, CHUNK_ANCHOR_JITTER);
+    }
+
+    // Unsmoothed heights of a chunk, the walk is bent so that it ends on the next chunk's first column
+    static res::NoiseArray getRawChunk(uint32_t seed, int64_t index, const int range = 2) {
+        Lehmer32 rnd = getChunkStream(seed, index, SALT_TERRAIN);
+        double left = getChunkAnchor(seed, index);
+        double right = getChunkAnchor(seed, index + 1);
 
-        for (const auto &noise: noiseArr) {
-            avgLandHeight += noise;
-            if (noise < minLandHeight) minLandHeight = noise;
-            if (noise > maxLandHeight) maxLandHeight = noise;
+        double acc[CHUNK_WIDTH + 1], step[CHUNK_WIDTH + 1];
+        rnd.fillDouble(acc, CHUNK_WIDTH + 1, -0.2, 0.2);
+        rnd.fillDouble(step, CHUNK_WIDTH + 1, -range, range);
+
+        std::vector<double> walk(CHUNK_WIDTH + 1);
+        double vel = 0;
+        for (int i = 1; i <= CHUNK_WIDTH; i++) {
+            vel = vel * 0.98 + acc[i];
+            if (vel > range) vel = range;
+            if (vel < -range) vel = -range;
+            walk[i] = walk[i - 1] + vel + step[i] / 2;
+        }
+
+        res::NoiseArray raw(CHUNK_WIDTH);
+        double drift = walk[CHUNK_WIDTH] - (right - left);
+        for (int i = 0; i < CHUNK_WIDTH; i++) {
+            raw[i] = left + walk[i] - drift * i / CHUNK_WIDTH;
+            if (raw[i] < UPPER_BOUND) raw[i] = UPPER_BOUND;
+            else if (raw[i] > LOWER_BOUND) raw[i] = LOWER_BOUND;
+        }
+        return raw;
+    }
+
+    // Smooths the chunk with its neighbours' raw heights, which keeps the seams continuous
+    static res::TerrainChunk getTerrainChunk(uint32_t seed, int64_t index) {
+        res::NoiseArray prev = getRawChunk(seed, index - 1);
+        res::NoiseArray cur = getRawChunk(seed, index);
+        res::NoiseArray next = getRawChunk(seed, index + 1);
+
+        // The chunk padded with its neighbours, so every column of the chunk sees a full window
+        res::NoiseArray padded(prev.end() - CHUNK_SMOOTH_RADIUS, prev.end());
+        padded.insert(padded.end(), cur.begin(), cur.end());
+        padded.insert(padded.end(), next.begin(), next.begin() + CHUNK_SMOOTH_RADIUS);
+        Smoother(Smoother::Mode::BOX, CHUNK_SMOOTH_RADIUS).apply(padded);
+
+        res::TerrainChunk chunk;
+        chunk.index = index;
+        chunk.heights.assign(padded.begin() + CHUNK_SMOOTH_RADIUS, padded.end() - CHUNK_SMOOTH_RADIUS);
+        for (const auto &height: chunk.heights)
+            chunk.stats.add(height);
+        return chunk;
+    }
+
+    // Builds the screen sized noise array, tree list and cloud list from the chunks under the camera
+    void buildChunkView(res::WorldState &world, double viewX) {
+        auto left = (int64_t) std::floor(viewX);
+        // One chunk of margin on each side, so trees and clouds hanging over the screen edge are drawn
+        int64_t firstChunk = floorDiv(left, CHUNK_WIDTH) - 1;
+        int64_t lastChunk = floorDiv(left + ScreenWidth() - 1, CHUNK_WIDTH) + 1;
+
+        for (auto it = chunkCache.begin(); it != chunkCache.end();) {
+            if (it->first < firstChunk || it->first > lastChunk) it = chunkCache.erase(it);
+            else ++it;
+        }
+
+        // Missing chunks do not depend on each other, so they are generated in parallel.
+        // Each worker counts its own allocations, which are added to this thread's count so the world's total has them
+        std::vector<std::future<std::pair<res::TerrainChunk, size_t>>> jobs;
+        for (int64_t index = firstChunk; index <= lastChunk; index++)
+            if (!chunkCache.count(index))
+                jobs.push_back(std::async(std::launch::async, [seed = world.seed, index] {
+                    size_t allocationsBefore = allocationCount;
+                    auto chunk = getTerrainChunk(seed, index);
+                    return std::make_pair(std::move(chunk), allocationCount - allocationsBefore);
+                }));
+        for (auto &job: jobs) {
+            auto [chunk, allocations] = job.get();
+            allocationCount += allocations;
+            chunkCache[chunk.index] = std::move(chunk);
+        }
+
+        world.noiseArray.resize(ScreenWidth());
+        for (int i = 0; i < ScreenWidth(); i++) {
+            int64_t x = left + i;
+            int64_t index = floorDiv(x, CHUNK_WIDTH);
+            world.noiseArray[i] = chunkCache[index].heights[x - index * CHUNK_WIDTH];
         }
 
-        avgLandHeight /= noiseArr.size();
+        for (const auto &[index, chunk]: chunkCache) {
+            auto offset = (int) (index * CHUNK_WIDTH - left);
+            Lehmer32 rnd = getChunkStream(world.seed, index, SALT_DECORATION);
+            size_t firstTree = world.treeList.size();
+            size_t firstCloud = world.cloudList.size();
+            getTreeList(TREE_FREQ, chunk.heights, 0, CHUNK_WIDTH, chunk.stats.avg(), world.treeList, rnd);
+            getCloudList(CLOUD_FREQ, 0, CHUNK_WIDTH, world.cloudList, rnd);
+            world.treeList.shift(firstTree, offset);
+            world.cloudList.shift(firstCloud, offset);
+        }
 
-        waterBoundHeight = (int) ((2 * avgLandHeight + maxLandHeight) / 3);
+        // Merged from the chunks under the camera, the margin chunks are left out
+        res::HeightStats stats(DBL_MAX, -DBL_MAX);
+        for (int64_t index = firstChunk + 1; index < lastChunk; index++)
+            stats.merge(chunkCache[index].stats);
+        world.minLandHeight = stats.min;
+        world.maxLandHeight = stats.max;
+        world.avgLandHeight = stats.avg();
 
-        return noiseArr;
+        // The water level has to stay put while scrolling, so it comes from the anchor range instead of the view
+        world.waterBoundHeight = (2 * (CHUNK_ANCHOR_MIN + CHUNK_ANCHOR_MAX) / 2 + CHUNK_ANCHOR_MAX) / 3;
     }
 
-    // drawTree(new res::Tree(100, 100, 16, 30, 10, resources.getTreeColor(3), resources.getTreeColor(0)));
-    void drawTree(const res::Tree *tree) {
-        FillRect(tree->x, tree->y - tree->height + TREE_BARK_HIDE_OFFSET, tree->width, tree->height, tree->barkColor);
-        FillCircle(tree->x + tree->width / 2, tree->y - tree->radius / 2 - tree->height + TREE_BARK_HIDE_OFFSET,
-                   tree->radius, tree->leafColor);
+    // The ground under a column is a few solid bands: grass or sand, then topsoil or wet soil, then dirt that turns
+    // into rock 40% of the way down. The band ends are found once per column and every band is drawn as one span
+    void drawGroundColumn(const olc::DrawContext &canvas, int x, double height, bool isWater,
+                          const ResourceContainer &resources) {
+        double depth = ScreenHeight() - height;
+        auto last = (int) std::floor(depth);
+        if (last < 0) return;
+
+        // First row whose depth ratio is above 0.4, with the same division the bands were first defined with
+        auto rock = (int) (0.4 * depth);
+        while (rock > 0 && (double) (rock - 1) / depth > 0.4) rock--;
+        while (!((double) rock / depth > 0.4)) rock++;
+
+        auto top = (int) height;
+        auto band = [&](int from, int to, int index) {
+            canvas.FillSpanV(x, top + from, top + std::min(to, last), olc::Pixel{resources.getEarthColor(index)});
+        };
+        band(0, 12, isWater ? 5 : 3);
+        band(13, 44, isWater ? 4 : 2);
+        band(45, rock - 1, 1);
+        band(std::max(45, rock), last, 0);
     }
 
-    res::TreeList
-    getTreeList(int frequency, res::NoiseArray &noiseArr, ResourceContainer &resources, Lehmer32 &rnd) {
-        res::TreeList tList;
-        int x = 40;
+    void
+    getTreeList(int frequency, res::WorldState &world, Lehmer32 &rnd) {
+        getTreeList(frequency, world.noiseArray, 40, ScreenWidth() - 40, world.avgLandHeight, world.treeList, rnd);
+    }
+
+    // Places trees on noiseArr[xFrom, xTo) wherever the land is higher than heightLimit, appending them to tList
+    static void
+    getTreeList(int frequency, const res::NoiseArray &noiseArr, int xFrom, int xTo, double heightLimit,
+                res::TreeList &tList, Lehmer32 &rnd) {
+        int x = xFrom;
         x += rnd.rndInt(frequency / 2, frequency / 2 * 3);
-        while (x < ScreenWidth() - 40) {
-            if (noiseArr[x] < avgLandHeight) {
+        while (x < xTo) {
+            if (noiseArr[x] < heightLimit) {
                 auto y = noiseArr[x];
                 auto w = rnd.rndInt(6, 14);
                 auto h = rnd.rndInt(36, 56) + TREE_BARK_HIDE_OFFSET;
                 auto r = rnd.rndDouble(2.1, 2.6) * w;
                 auto leaf = rnd.rndInt(0, 3);
                 auto bark = 3;
-                tList.push_back(
-                        new res::Tree(x, (int) y, (int) r, h, w, resources.getTreeColor(bark),
-                                      resources.getTreeColor(leaf)));
+                tList.add(x, (int) y, (int) r, h, w, bark, leaf);
             }
             x += rnd.rndInt(frequency / 2, frequency / 2 * 3);
         }
-        return tList;
     }
 
     void
-    drawCloud(const res::Cloud *cloud) {
-        for (const auto &cloudPart: cloud->cloudParts) {
-            FillCircle(cloudPart->x, cloudPart->y, cloudPart->r, cloudPart->color);
-        }
+    getCloudList(int frequency, res::WorldState &world, Lehmer32 &rnd) {
+        getCloudList(frequency, 60, ScreenWidth() - 60, world.cloudList, rnd);
     }
 
-    res::CloudList
-    getCloudList(int frequency, ResourceContainer &resources, Lehmer32 &rnd) {
-        res::CloudList cList;
-        int x = 60;
+    // Places clouds on [xFrom, xTo), appending them to cList
+    static void
+    getCloudList(int frequency, int xFrom, int xTo, res::CloudList &cList, Lehmer32 &rnd) {
+        int x = xFrom;
         x += rnd.rndInt(frequency / 2, frequency / 2 * 5);
-        while (x < ScreenWidth() - 60) {
+        while (x < xTo) {
             int y = rnd.rndInt(CLOUD_UPPER_BOUND, CLOUD_LOWER_BOUND);
-            cList.push_back(getCloud(rnd.rndInt(N_CLOUD_PARTICLES_MIN, N_CLOUD_PARTICLES_MAX), x, y, rnd, resources));
+            getCloud(rnd.rndInt(N_CLOUD_PARTICLES_MIN, N_CLOUD_PARTICLES_MAX), x, y, cList, rnd);
             x += rnd.rndInt(frequency / 2, frequency / 2 * 5);
         }
-        return cList;
     }
 
-    static res::Cloud *
-    getCloud(int nParticles, int x, int y, Lehmer32 &rnd, ResourceContainer &resources) {
-        auto cloudPtr = new res::Cloud(x, y);
+    static void
+    getCloud(int nParticles, int x, int y, res::CloudList &cList, Lehmer32 &rnd) {
+        cList.add(x, y);
         while (nParticles-- > 0) {
-            cloudPtr->cloudParts.push_back(
-                    new res::CloudPart(x + rnd.rndInt(-X_CLOUD_PARTICLE_RANGE, +X_CLOUD_PARTICLE_RANGE),
-                                       y + rnd.rndInt(-Y_CLOUD_PARTICLE_RANGE, +Y_CLOUD_PARTICLE_RANGE),
-                                       rnd.rndInt(CLOUD_PART_RADIUS_MIN, CLOUD_PART_RADIUS_MAX),
-                                       resources.getCloudColor()));
+            cList.addPart(x + rnd.rndInt(-X_CLOUD_PARTICLE_RANGE, +X_CLOUD_PARTICLE_RANGE),
+                          y + rnd.rndInt(-Y_CLOUD_PARTICLE_RANGE, +Y_CLOUD_PARTICLE_RANGE),
+                          rnd.rndInt(CLOUD_PART_RADIUS_MIN, CLOUD_PART_RADIUS_MAX), 0);
         }
-        return cloudPtr;
+        cList.finish();
     }
 };
 
 int main() {
-    if (World demo; demo.Construct(1864, 920, 1, 1))
+#if defined(WORLD_HEADLESS)
+    olc::Platform_Headless::SetFrameLimit(WORLD_HEADLESS_FRAMES);
+#endif
+
+    if (World demo; demo.Construct(1864, 920, 1, 1, false, false, false, PIPELINED))
         demo.Start();
 
+#if defined(WORLD_HEADLESS)
+    const uint32_t frames = olc::Platform_Headless::GetFrameCount();
+    const float seconds = olc::Platform_Headless::GetRunTime();
+    std::printf("%u frames in %.3f s, %.3f ms/frame\n", frames, seconds,
+                frames ? 1000.0f * seconds / float(frames) : 0.0f);
+    // A frame that shows the same scene again uploads nothing
+    std::printf("%.1f KB/frame uploaded\n",
+                frames ? double(olc::Platform_Headless::GetUploadBytes()) / 1024.0 / double(frames) : 0.0);
+    std::printf("%.3f ms from input to present%s\n", 1000.0f * olc::Platform_Headless::GetMeanLatency(),
+                PIPELINED ? ", pipelined" : "");
+    // An idle world only makes the frames it needs, the CPU time shows what the rest cost
+    if (IDLE) std::printf("%u frames made, the others were idle\n", olc::Platform_Headless::GetPresentCount());
+    std::printf("%.3f s of CPU time\n", double(std::clock()) / CLOCKS_PER_SEC);
+#endif
+
     return 0;
 }
@@ -282,6 +282,24 @@
 		  +Reintroduced sub-pixel decals
 		  +Modified DrawPartialDecal() to quantise and correctly sample from tile atlasses
 		  +olc::Sprite::GetPixel() - Clamp Mode
+		  +FillSpanH()/FillSpanV() - clipped spans written straight to the draw target
+		  +olc::Platform_Headless and olc::Renderer_Software - run without a display or GPU
+		  +Renderer_Software composites on a thread pool by tiles, with every DecalMode and DecalStructure
+		  +olc::DrawContext - the drawing routines on a sprite and clip rectangle, usable from any thread
+		  =Pixel::ALPHA blends in 8 bit fixed point, spans and sprite rows with SSE2/AVX2
+		  +olc::blend - the pixel modes as types, DrawContext routines taking one are compiled for it
+		  =Filled shapes and sprites look at the pixel mode once per primitive, not once per pixel
+		  =Pixel::MASK sprite rows are copied with SSE2/AVX2
+		  =FillRect(), FillCircle(), FillTriangle() and Clear() fill whole spans, vectorised where possible
+		  +olc::Sprite dirty area - layers upload only what was drawn since the last frame, GetUploadBytes()
+		  +OLC_PBO_RING - Renderer_OGL33 can stream texture uploads through a ring of pixel buffers
+		  +Pipelined mode (flag in Construct()) - OnUserUpdate() makes a frame while the last is presented
+		  +GetFrameLatency() - time from a frame reading its input until it was presented
+		  +SetFrameRateLimit(), SetFixedTimeStep() - frames are paced by sleeping, not spinning
+		  +SetIdleMode(), RequestRedraw() - only make a frame for input or when asked to
+		  =Input reaches the engine through olc::InputQueue, a key tapped between frames is still pressed and released
+		  +GetInputEvents(), GetInputLatency() - this frame's input in order, and how long it took to show
+		  =Linux key autorepeat keeps a key held, it no longer shows as the key released and pressed again
 
 		  
     !! Apple Platforms will not see these updates immediately - Sorry, I dont have a mac to test... !!
@@ -354,6 +372,8 @@ int main()
 #include <list>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <fstream>
 #include <map>
 #include <functional>
@@ -400,6 +420,18 @@ int main()
 
 #define UNUSED(x) (void)(x)
 
+// Vectorised pixel fills and blends, define OLC_DISABLE_SIMD to always use the plain loops
+#if !defined(OLC_DISABLE_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define OLC_SIMD_SSE2
+		#include <emmintrin.h>
+	#endif
+	#if defined(__AVX2__)
+		#define OLC_SIMD_AVX2
+		#include <immintrin.h>
+	#endif
+#endif
+
 // O------------------------------------------------------------------------------O
 // | PLATFORM SELECTION CODE, Thanks slavka!                                      |
 // O------------------------------------------------------------------------------O
@@ -483,7 +515,11 @@ int main()
 	{
 		#include <X11/X.h>
 		#include <X11/Xlib.h>
+		#include <X11/XKBlib.h>
 	}
+	#include <poll.h>
+	#include <unistd.h>
+	#include <fcntl.h>
 #endif
 
 #if defined(OLC_PLATFORM_GLUT)
@@ -598,6 +634,42 @@ namespace olc
 		bool bHeld = false;		// Set true for all frames between pressed and released events
 	};
 
+	// O------------------------------------------------------------------------------O
+	// | olc::InputEvent - A change to a hardware input, stamped with when it happened |
+	// O------------------------------------------------------------------------------O
+	struct InputEvent
+	{
+		enum class Type : uint8_t { KEY, MOUSE_BUTTON, MOUSE_MOVE, MOUSE_WHEEL, KEY_FOCUS, MOUSE_FOCUS };
+		Type type = Type::KEY;
+		bool bState = false;	// KEY and MOUSE_BUTTON: down or up, KEY_FOCUS and MOUSE_FOCUS: gained or lost
+		int32_t nCode = 0;		// KEY: olc::Key, MOUSE_BUTTON: button, MOUSE_WHEEL: delta
+		int32_t x = 0, y = 0;	// MOUSE_MOVE: position in "pixel" space
+		int32_t wx = 0, wy = 0;	// MOUSE_MOVE: position in the window
+		std::chrono::time_point<std::chrono::system_clock> tpTime;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | olc::InputQueue - Lock-free ring of InputEvents from one thread to another   |
+	// O------------------------------------------------------------------------------O
+	class InputQueue
+	{
+	public:
+		static constexpr uint32_t nCapacity = 1024;
+		InputQueue();
+		// Only called by the thread events come from, false if the queue is full and e was dropped
+		bool Push(const InputEvent& e);
+		// Only called by the thread events go to, false if there was nothing to take
+		bool Pop(InputEvent& e);
+		// Events waiting, as last seen from either side
+		uint32_t Size() const;
+
+	private:
+		// Each side moves only its own index, on its own cache line
+		alignas(64) std::atomic<uint32_t> nHead{ 0 };
+		alignas(64) std::atomic<uint32_t> nTail{ 0 };
+		std::vector<InputEvent> vEvents;
+	};
+
 
 
 
@@ -755,6 +827,21 @@ namespace olc
 		Mode modeSample = Mode::NORMAL;
 
 		static std::unique_ptr<olc::ImageLoader> loader;
+
+	public:
+		// The area written since ClearDirty(), a decal of the sprite uploads only that. Drawing
+		// routines mark what they write, writes through GetData() or pColData must be marked
+		// with SetDirty(). Marking is safe from several threads at once
+		void SetDirty();
+		void SetDirty(int32_t x, int32_t y, int32_t w, int32_t h);
+		void ClearDirty();
+		bool IsDirty() const;
+		olc::vi2d GetDirtyPos() const;
+		olc::vi2d GetDirtySize() const;
+
+	private:
+		// Max is exclusive, a new sprite is dirty all over
+		std::atomic<int32_t> nDirtyMinX{ 0 }, nDirtyMinY{ 0 }, nDirtyMaxX{ INT32_MAX }, nDirtyMaxY{ INT32_MAX };
 	};
 
 	// O------------------------------------------------------------------------------O
@@ -767,6 +854,8 @@ namespace olc
 		Decal(const uint32_t nExistingTextureResource, olc::Sprite* spr);
 		virtual ~Decal();
 		void Update();
+		// As Update(), but only the dirty area of the sprite and nothing if it is clean
+		void UpdateDirty();
 		void UpdateSprite();
 
 	public: // But dont touch
@@ -813,6 +902,567 @@ namespace olc
 		std::unique_ptr<olc::Decal> pDecal = nullptr;
 	};
 
+	// O------------------------------------------------------------------------------O
+	// | Rasterisers shared by olc::PixelGameEngine and olc::DrawContext              |
+	// O------------------------------------------------------------------------------O
+	// They only work out which pixels a shape covers, plot(x, y) and span(x1, x2, y) draw them
+	namespace raster
+	{
+		template<typename Plot>
+		void Line(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t pattern, Plot plot)
+		{
+			int x, y, dx, dy, dx1, dy1, px, py, xe, ye, i;
+			dx = x2 - x1; dy = y2 - y1;
+
+			auto rol = [&](void) { pattern = (pattern << 1) | (pattern >> 31); return pattern & 1; };
+
+			// straight lines idea by gurkanctn
+			if (dx == 0) // Line is vertical
+			{
+				if (y2 < y1) std::swap(y1, y2);
+				for (y = y1; y <= y2; y++) if (rol()) plot(x1, y);
+				return;
+			}
+
+			if (dy == 0) // Line is horizontal
+			{
+				if (x2 < x1) std::swap(x1, x2);
+				for (x = x1; x <= x2; x++) if (rol()) plot(x, y1);
+				return;
+			}
+
+			// Line is Funk-aye
+			dx1 = abs(dx); dy1 = abs(dy);
+			px = 2 * dy1 - dx1;	py = 2 * dx1 - dy1;
+			if (dy1 <= dx1)
+			{
+				if (dx >= 0)
+				{
+					x = x1; y = y1; xe = x2;
+				}
+				else
+				{
+					x = x2; y = y2; xe = x1;
+				}
+
+				if (rol()) plot(x, y);
+
+				for (i = 0; x < xe; i++)
+				{
+					x = x + 1;
+					if (px < 0)
+						px = px + 2 * dy1;
+					else
+					{
+						if ((dx < 0 && dy < 0) || (dx > 0 && dy > 0)) y = y + 1; else y = y - 1;
+						px = px + 2 * (dy1 - dx1);
+					}
+					if (rol()) plot(x, y);
+				}
+			}
+			else
+			{
+				if (dy >= 0)
+				{
+					x = x1; y = y1; ye = y2;
+				}
+				else
+				{
+					x = x2; y = y2; ye = y1;
+				}
+
+				if (rol()) plot(x, y);
+
+				for (i = 0; y < ye; i++)
+				{
+					y = y + 1;
+					if (py <= 0)
+						py = py + 2 * dx1;
+					else
+					{
+						if ((dx < 0 && dy < 0) || (dx > 0 && dy > 0)) x = x + 1; else x = x - 1;
+						py = py + 2 * (dx1 - dy1);
+					}
+					if (rol()) plot(x, y);
+				}
+			}
+		}
+
+		// Radius must be above 0
+		template<typename Plot>
+		void Circle(int32_t x, int32_t y, int32_t radius, uint8_t mask, Plot plot)
+		{ // Thanks to IanM-Matrix1 #PR121
+			int x0 = 0;
+			int y0 = radius;
+			int d = 3 - 2 * radius;
+
+			while (y0 >= x0) // only formulate 1/8 of circle
+			{
+				// Draw even octants
+				if (mask & 0x01) plot(x + x0, y - y0);// Q6 - upper right right
+				if (mask & 0x04) plot(x + y0, y + x0);// Q4 - lower lower right
+				if (mask & 0x10) plot(x - x0, y + y0);// Q2 - lower left left
+				if (mask & 0x40) plot(x - y0, y - x0);// Q0 - upper upper left
+				if (x0 != 0 && x0 != y0)
+				{
+					if (mask & 0x02) plot(x + y0, y - x0);// Q7 - upper upper right
+					if (mask & 0x08) plot(x + x0, y + y0);// Q5 - lower right right
+					if (mask & 0x20) plot(x - y0, y + x0);// Q3 - lower lower left
+					if (mask & 0x80) plot(x - x0, y - y0);// Q1 - upper left left
+				}
+
+				if (d < 0)
+					d += 4 * x0++ + 6;
+				else
+					d += 4 * (x0++ - y0--) + 10;
+			}
+		}
+
+		// Radius must be above 0
+		template<typename Span>
+		void FilledCircle(int32_t x, int32_t y, int32_t radius, Span span)
+		{ // Thanks to IanM-Matrix1 #PR121
+			int x0 = 0;
+			int y0 = radius;
+			int d = 3 - 2 * radius;
+
+			while (y0 >= x0)
+			{
+				span(x - y0, x + y0, y - x0);
+				if (x0 > 0)	span(x - y0, x + y0, y + x0);
+
+				if (d < 0)
+					d += 4 * x0++ + 6;
+				else
+				{
+					if (x0 != y0)
+					{
+						span(x - x0, x + x0, y - y0);
+						span(x - x0, x + x0, y + y0);
+					}
+					d += 4 * (x0++ - y0--) + 10;
+				}
+			}
+		}
+
+		// https://www.avrfreaks.net/sites/default/files/triangles.c
+		template<typename Span>
+		void FilledTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Span drawline)
+		{
+			int t1x, t2x, y, minx, maxx, t1xp, t2xp;
+			bool changed1 = false;
+			bool changed2 = false;
+			int signx1, signx2, dx1, dy1, dx2, dy2;
+			int e1, e2;
+			// Sort vertices
+			if (y1 > y2) { std::swap(y1, y2); std::swap(x1, x2); }
+			if (y1 > y3) { std::swap(y1, y3); std::swap(x1, x3); }
+			if (y2 > y3) { std::swap(y2, y3); std::swap(x2, x3); }
+
+			t1x = t2x = x1; y = y1;   // Starting points
+			dx1 = (int)(x2 - x1);
+			if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
+			else signx1 = 1;
+			dy1 = (int)(y2 - y1);
+
+			dx2 = (int)(x3 - x1);
+			if (dx2 < 0) { dx2 = -dx2; signx2 = -1; }
+			else signx2 = 1;
+			dy2 = (int)(y3 - y1);
+
+			if (dy1 > dx1) { std::swap(dx1, dy1); changed1 = true; }
+			if (dy2 > dx2) { std::swap(dy2, dx2); changed2 = true; }
+
+			e2 = (int)(dx2 >> 1);
+			// Flat top, just process the second half
+			if (y1 == y2) goto next;
+			e1 = (int)(dx1 >> 1);
+
+			for (int i = 0; i < dx1;) {
+				t1xp = 0; t2xp = 0;
+				if (t1x < t2x) { minx = t1x; maxx = t2x; }
+				else { minx = t2x; maxx = t1x; }
+				// process first line until y value is about to change
+				while (i < dx1) {
+					i++;
+					e1 += dy1;
+					while (e1 >= dx1) {
+						e1 -= dx1;
+						if (changed1) t1xp = signx1;//t1x += signx1;
+						else          goto next1;
+					}
+					if (changed1) break;
+					else t1x += signx1;
+				}
+				// Move line
+			next1:
+				// process second line until y value is about to change
+				while (1) {
+					e2 += dy2;
+					while (e2 >= dx2) {
+						e2 -= dx2;
+						if (changed2) t2xp = signx2;//t2x += signx2;
+						else          goto next2;
+					}
+					if (changed2)     break;
+					else              t2x += signx2;
+				}
+			next2:
+				if (minx > t1x) minx = t1x;
+				if (minx > t2x) minx = t2x;
+				if (maxx < t1x) maxx = t1x;
+				if (maxx < t2x) maxx = t2x;
+				drawline(minx, maxx, y);    // Draw line from min to max points found on the y
+											// Now increase y
+				if (!changed1) t1x += signx1;
+				t1x += t1xp;
+				if (!changed2) t2x += signx2;
+				t2x += t2xp;
+				y += 1;
+				if (y == y2) break;
+			}
+		next:
+			// Second half
+			dx1 = (int)(x3 - x2); if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
+			else signx1 = 1;
+			dy1 = (int)(y3 - y2);
+			t1x = x2;
+
+			if (dy1 > dx1) {   // swap values
+				std::swap(dy1, dx1);
+				changed1 = true;
+			}
+			else changed1 = false;
+
+			e1 = (int)(dx1 >> 1);
+
+			for (int i = 0; i <= dx1; i++) {
+				t1xp = 0; t2xp = 0;
+				if (t1x < t2x) { minx = t1x; maxx = t2x; }
+				else { minx = t2x; maxx = t1x; }
+				// process first line until y value is about to change
+				while (i < dx1) {
+					e1 += dy1;
+					while (e1 >= dx1) {
+						e1 -= dx1;
+						if (changed1) { t1xp = signx1; break; }//t1x += signx1;
+						else          goto next3;
+					}
+					if (changed1) break;
+					else   	   	  t1x += signx1;
+					if (i < dx1) i++;
+				}
+			next3:
+				// process second line until y value is about to change
+				while (t2x != x3) {
+					e2 += dy2;
+					while (e2 >= dx2) {
+						e2 -= dx2;
+						if (changed2) t2xp = signx2;
+						else          goto next4;
+					}
+					if (changed2)     break;
+					else              t2x += signx2;
+				}
+			next4:
+
+				if (minx > t1x) minx = t1x;
+				if (minx > t2x) minx = t2x;
+				if (maxx < t1x) maxx = t1x;
+				if (maxx < t2x) maxx = t2x;
+				drawline(minx, maxx, y);
+				if (!changed1) t1x += signx1;
+				t1x += t1xp;
+				if (!changed2) t2x += signx2;
+				t2x += t2xp;
+				y += 1;
+				if (y > y3) return;
+			}
+		}
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::blend - The pixel modes as types                                        |
+	// O------------------------------------------------------------------------------O
+	// blend(x, y, p, d) writes source p over destination d at (x,y), false if d is left as
+	// it was. Fill() and Copy() do a row at a time, Span gives per pixel ones to build on.
+	// Drawing routines taking a blend are compiled for it, so it is inlined into them.
+	namespace blend
+	{
+		template<typename Op>
+		struct Span
+		{
+			void Fill(Pixel* pDst, int32_t nCount, int32_t x, int32_t y, Pixel p) const
+			{ for (int32_t i = 0; i < nCount; i++) static_cast<const Op&>(*this)(x + i, y, p, pDst[i]); }
+			void Copy(Pixel* pDst, const Pixel* pSrc, int32_t nCount, int32_t x, int32_t y) const
+			{ for (int32_t i = 0; i < nCount; i++) static_cast<const Op&>(*this)(x + i, y, pSrc[i], pDst[i]); }
+		};
+
+		// Pixel::NORMAL
+		struct Normal : Span<Normal>
+		{
+			bool operator()(int32_t, int32_t, Pixel p, Pixel& d) const { d = p; return true; }
+			void Fill(Pixel* pDst, int32_t nCount, int32_t x, int32_t y, Pixel p) const;
+			void Copy(Pixel* pDst, const Pixel* pSrc, int32_t nCount, int32_t x, int32_t y) const;
+		};
+
+		// Pixel::MASK
+		struct Mask : Span<Mask>
+		{
+			bool operator()(int32_t, int32_t, Pixel p, Pixel& d) const { if (p.a != 255) return false; d = p; return true; }
+			void Fill(Pixel* pDst, int32_t nCount, int32_t x, int32_t y, Pixel p) const;
+			void Copy(Pixel* pDst, const Pixel* pSrc, int32_t nCount, int32_t x, int32_t y) const;
+		};
+
+		// Pixel::ALPHA, in 8 bit fixed point and so within 1 of blending in floats
+		struct Alpha : Span<Alpha>
+		{
+			explicit Alpha(float fBlend = 1.0f) : nBlend(uint32_t(std::min(1.0f, std::max(0.0f, fBlend)) * 255.0f + 0.5f)) {}
+			bool operator()(int32_t, int32_t, Pixel p, Pixel& d) const { d = Blend(d, p, nBlend); return true; }
+			void Fill(Pixel* pDst, int32_t nCount, int32_t x, int32_t y, Pixel p) const;
+			void Copy(Pixel* pDst, const Pixel* pSrc, int32_t nCount, int32_t x, int32_t y) const;
+
+			static Pixel Blend(Pixel d, Pixel p, uint32_t nBlend)
+			{
+				const uint32_t a = (p.a * nBlend + 127) / 255, c = 255 - a;
+				return Pixel(uint8_t((p.r * a + d.r * c) / 255), uint8_t((p.g * a + d.g * c) / 255), uint8_t((p.b * a + d.b * c) / 255));
+			}
+
+			uint32_t nBlend; // The blend factor, 0 to 255
+		};
+
+		// Pixel::CUSTOM, func is called as the one given to PixelGameEngine::SetPixelMode()
+		template<typename F>
+		struct Custom : Span<Custom<F>>
+		{
+			Custom(F f) : func(f) {}
+			bool operator()(int32_t x, int32_t y, Pixel p, Pixel& d) const { d = func(x, y, p, d); return true; }
+			F func;
+		};
+
+		// Calls f with the blend for a pixel mode, once per primitive rather than once per pixel
+		template<typename F>
+		void Dispatch(Pixel::Mode m, float fBlend, const std::function<olc::Pixel(const int x, const int y, const olc::Pixel&, const olc::Pixel&)>& func, F&& f)
+		{
+			switch (m)
+			{
+			case Pixel::NORMAL: f(Normal()); break;
+			case Pixel::MASK: f(Mask()); break;
+			case Pixel::ALPHA: f(Alpha(fBlend)); break;
+			case Pixel::CUSTOM: f(Custom<decltype(func)>(func)); break;
+			}
+		}
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::DrawContext - A draw target, clip rectangle and pixel mode in one value |
+	// O------------------------------------------------------------------------------O
+	// The drawing routines of the engine, without the engine. Nothing is shared between
+	// contexts, so any number of threads can draw at once, each with its own context.
+	// Contexts drawing to the same sprite at the same time must not overlap.
+	class DrawContext
+	{
+	public:
+		DrawContext() = default;
+		// Draws to the whole of target, DrawString() needs a font sprite laid out as the engine's
+		DrawContext(olc::Sprite* target, const olc::Sprite* font = nullptr);
+
+	public:
+		// A copy clipped to the area (x,y) to (x+w,y+h) inside the current clip
+		DrawContext Clip(int32_t x, int32_t y, int32_t w, int32_t h) const;
+		DrawContext Clip(const olc::vi2d& pos, const olc::vi2d& size) const;
+		// A copy with another pixel mode, as PixelGameEngine::SetPixelMode() and SetPixelBlend()
+		DrawContext WithPixelMode(Pixel::Mode m, float fBlend = 1.0f) const;
+		DrawContext WithPixelMode(std::function<olc::Pixel(const int x, const int y, const olc::Pixel& pSource, const olc::Pixel& pDest)> pixelMode) const;
+
+		olc::Sprite* GetTarget() const;
+		olc::vi2d GetClipPos() const;
+		olc::vi2d GetClipSize() const;
+		Pixel::Mode GetPixelMode() const;
+
+	public: // DRAWING ROUTINES, as those of olc::PixelGameEngine but clipped
+		bool Draw(int32_t x, int32_t y, Pixel p = olc::WHITE) const;
+		bool Draw(const olc::vi2d& pos, Pixel p = olc::WHITE) const;
+		void DrawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF) const;
+		void DrawLine(const olc::vi2d& pos1, const olc::vi2d& pos2, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF) const;
+		void DrawCircle(int32_t x, int32_t y, int32_t radius, Pixel p = olc::WHITE, uint8_t mask = 0xFF) const;
+		void DrawCircle(const olc::vi2d& pos, int32_t radius, Pixel p = olc::WHITE, uint8_t mask = 0xFF) const;
+		void FillCircle(int32_t x, int32_t y, int32_t radius, Pixel p = olc::WHITE) const;
+		void FillCircle(const olc::vi2d& pos, int32_t radius, Pixel p = olc::WHITE) const;
+		void DrawRect(int32_t x, int32_t y, int32_t w, int32_t h, Pixel p = olc::WHITE) const;
+		void DrawRect(const olc::vi2d& pos, const olc::vi2d& size, Pixel p = olc::WHITE) const;
+		void FillRect(int32_t x, int32_t y, int32_t w, int32_t h, Pixel p = olc::WHITE) const;
+		void FillRect(const olc::vi2d& pos, const olc::vi2d& size, Pixel p = olc::WHITE) const;
+		void DrawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p = olc::WHITE) const;
+		void DrawTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p = olc::WHITE) const;
+		void FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p = olc::WHITE) const;
+		void FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p = olc::WHITE) const;
+		void FillSpanH(int32_t x1, int32_t x2, int32_t y, Pixel p = olc::WHITE) const;
+		void FillSpanV(int32_t x, int32_t y1, int32_t y2, Pixel p = olc::WHITE) const;
+		void DrawSprite(int32_t x, int32_t y, const Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE) const;
+		void DrawSprite(const olc::vi2d& pos, const Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE) const;
+		void DrawPartialSprite(int32_t x, int32_t y, const Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE) const;
+		void DrawPartialSprite(const olc::vi2d& pos, const Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE) const;
+		void DrawString(int32_t x, int32_t y, const std::string& sText, Pixel col = olc::WHITE, uint32_t scale = 1) const;
+		void DrawString(const olc::vi2d& pos, const std::string& sText, Pixel col = olc::WHITE, uint32_t scale = 1) const;
+		// Fills the clip area, whatever the pixel mode
+		void Clear(Pixel p) const;
+
+	public: // DRAWING ROUTINES compiled for a blend from olc::blend, or one like them, the pixel mode is not used
+		template<typename Blend> bool Draw(const Blend& blend, int32_t x, int32_t y, Pixel p) const;
+		template<typename Blend> void DrawLine(const Blend& blend, int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p, uint32_t pattern = 0xFFFFFFFF) const;
+		template<typename Blend> void DrawCircle(const Blend& blend, int32_t x, int32_t y, int32_t radius, Pixel p, uint8_t mask = 0xFF) const;
+		template<typename Blend> void FillCircle(const Blend& blend, int32_t x, int32_t y, int32_t radius, Pixel p) const;
+		template<typename Blend> void FillRect(const Blend& blend, int32_t x, int32_t y, int32_t w, int32_t h, Pixel p) const;
+		template<typename Blend> void FillTriangle(const Blend& blend, int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p) const;
+		template<typename Blend> void FillSpanH(const Blend& blend, int32_t x1, int32_t x2, int32_t y, Pixel p) const;
+		template<typename Blend> void FillSpanV(const Blend& blend, int32_t x, int32_t y1, int32_t y2, Pixel p) const;
+		// nCount pixels from pSrc, the first drawn at (x,y)
+		template<typename Blend> void DrawSpan(const Blend& blend, int32_t x, int32_t y, const Pixel* pSrc, int32_t nCount) const;
+		template<typename Blend> void DrawSprite(const Blend& blend, int32_t x, int32_t y, const Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE) const;
+		template<typename Blend> void DrawPartialSprite(const Blend& blend, int32_t x, int32_t y, const Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE) const;
+
+	private:
+		// Calls f with the blend for the pixel mode
+		template<typename F> void Dispatch(F&& f) const
+		{ blend::Dispatch(nPixelMode, fBlendFactor, funcPixelMode, std::forward<F>(f)); }
+
+	private:
+		olc::Sprite* pTarget = nullptr;
+		const olc::Sprite* pFont = nullptr;
+		olc::vi2d vClipMin = { 0, 0 };
+		olc::vi2d vClipMax = { 0, 0 }; // Exclusive
+		Pixel::Mode nPixelMode = Pixel::NORMAL;
+		float fBlendFactor = 1.0f;
+		std::function<olc::Pixel(const int x, const int y, const olc::Pixel&, const olc::Pixel&)> funcPixelMode;
+	};
+
+	template<typename Blend>
+	bool DrawContext::Draw(const Blend& blend, int32_t x, int32_t y, Pixel p) const
+	{
+		if (x < vClipMin.x || y < vClipMin.y || x >= vClipMax.x || y >= vClipMax.y) return false;
+		if (!blend(x, y, p, pTarget->pColData[y * pTarget->width + x])) return false;
+		pTarget->SetDirty(x, y, 1, 1);
+		return true;
+	}
+
+	template<typename Blend>
+	void DrawContext::DrawLine(const Blend& blend, int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p, uint32_t pattern) const
+	{ raster::Line(x1, y1, x2, y2, pattern, [&](int32_t x, int32_t y) { Draw(blend, x, y, p); }); }
+
+	template<typename Blend>
+	void DrawContext::DrawCircle(const Blend& blend, int32_t x, int32_t y, int32_t radius, Pixel p, uint8_t mask) const
+	{
+		if (radius < 0 || x + radius < vClipMin.x || y + radius < vClipMin.y || x - radius >= vClipMax.x || y - radius >= vClipMax.y)
+			return;
+
+		if (radius > 0)
+			raster::Circle(x, y, radius, mask, [&](int32_t px, int32_t py) { Draw(blend, px, py, p); });
+		else
+			Draw(blend, x, y, p);
+	}
+
+	template<typename Blend>
+	void DrawContext::FillCircle(const Blend& blend, int32_t x, int32_t y, int32_t radius, Pixel p) const
+	{
+		if (radius < 0 || x + radius < vClipMin.x || y + radius < vClipMin.y || x - radius >= vClipMax.x || y - radius >= vClipMax.y)
+			return;
+
+		if (radius > 0)
+			raster::FilledCircle(x, y, radius, [&](int32_t sx, int32_t ex, int32_t sy) { FillSpanH(blend, sx, ex, sy, p); });
+		else
+			Draw(blend, x, y, p);
+	}
+
+	template<typename Blend>
+	void DrawContext::FillRect(const Blend& blend, int32_t x, int32_t y, int32_t w, int32_t h, Pixel p) const
+	{
+		for (int32_t j = std::max(y, vClipMin.y); j < std::min(y + h, vClipMax.y); j++)
+			FillSpanH(blend, x, x + w - 1, j, p);
+	}
+
+	template<typename Blend>
+	void DrawContext::FillTriangle(const Blend& blend, int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p) const
+	{ raster::FilledTriangle(x1, y1, x2, y2, x3, y3, [&](int32_t sx, int32_t ex, int32_t y) { FillSpanH(blend, sx, ex, y, p); }); }
+
+	template<typename Blend>
+	void DrawContext::FillSpanH(const Blend& blend, int32_t x1, int32_t x2, int32_t y, Pixel p) const
+	{
+		if (y < vClipMin.y || y >= vClipMax.y) return;
+		x1 = std::max(x1, vClipMin.x);
+		x2 = std::min(x2, vClipMax.x - 1);
+		if (x2 < x1) return;
+		blend.Fill(pTarget->GetData() + y * pTarget->width + x1, x2 - x1 + 1, x1, y, p);
+		pTarget->SetDirty(x1, y, x2 - x1 + 1, 1);
+	}
+
+	template<typename Blend>
+	void DrawContext::FillSpanV(const Blend& blend, int32_t x, int32_t y1, int32_t y2, Pixel p) const
+	{
+		if (x < vClipMin.x || x >= vClipMax.x) return;
+		y1 = std::max(y1, vClipMin.y);
+		y2 = std::min(y2, vClipMax.y - 1);
+		if (y2 < y1) return;
+		Pixel* m = pTarget->GetData() + y1 * pTarget->width + x;
+		for (int32_t y = y1; y <= y2; y++, m += pTarget->width) blend(x, y, p, *m);
+		pTarget->SetDirty(x, y1, 1, y2 - y1 + 1);
+	}
+
+	template<typename Blend>
+	void DrawContext::DrawSpan(const Blend& blend, int32_t x, int32_t y, const Pixel* pSrc, int32_t nCount) const
+	{
+		if (y < vClipMin.y || y >= vClipMax.y) return;
+		const int32_t sx = std::max(x, vClipMin.x), ex = std::min(x + nCount, vClipMax.x);
+		if (ex <= sx) return;
+		blend.Copy(pTarget->GetData() + y * pTarget->width + sx, pSrc + (sx - x), ex - sx, sx, y);
+		pTarget->SetDirty(sx, y, ex - sx, 1);
+	}
+
+	template<typename Blend>
+	void DrawContext::DrawSprite(const Blend& blend, int32_t x, int32_t y, const Sprite* sprite, uint32_t scale, uint8_t flip) const
+	{
+		if (sprite == nullptr)
+			return;
+		DrawPartialSprite(blend, x, y, sprite, 0, 0, sprite->width, sprite->height, scale, flip);
+	}
+
+	template<typename Blend>
+	void DrawContext::DrawPartialSprite(const Blend& blend, int32_t x, int32_t y, const Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip) const
+	{
+		if (sprite == nullptr || scale == 0)
+			return;
+
+		// Only the part of the sprite inside the clip is visited, row by row
+		const int32_t s = int32_t(scale);
+		const int32_t sx = std::max(x, vClipMin.x), ex = std::min(x + w * s, vClipMax.x);
+		const int32_t sy = std::max(y, vClipMin.y), ey = std::min(y + h * s, vClipMax.y);
+
+		// Unscaled rows inside the sprite are drawn straight from it
+		if (s == 1 && !(flip & olc::Sprite::Flip::HORIZ) && ox >= 0 && oy >= 0 && ox + w <= sprite->width && oy + h <= sprite->height)
+		{
+			for (int32_t py = sy; py < ey; py++)
+			{
+				const int32_t fy = (flip & olc::Sprite::Flip::VERT) ? h - 1 - (py - y) : py - y;
+				DrawSpan(blend, x, py, sprite->pColData.data() + (fy + oy) * sprite->width + ox, w);
+			}
+			return;
+		}
+
+		for (int32_t py = sy; py < ey; py++)
+		{
+			const int32_t j = (py - y) / s;
+			const int32_t fy = (flip & olc::Sprite::Flip::VERT) ? h - 1 - j : j;
+			Pixel* m = pTarget->GetData() + py * pTarget->width;
+			for (int32_t px = sx; px < ex; px++)
+			{
+				const int32_t i = (px - x) / s;
+				const int32_t fx = (flip & olc::Sprite::Flip::HORIZ) ? w - 1 - i : i;
+				blend(px, py, sprite->GetPixel(fx + ox, fy + oy), m[px]);
+			}
+		}
+		pTarget->SetDirty(sx, sy, ex - sx, ey - sy);
+	}
+
 
 	// O------------------------------------------------------------------------------O
 	// | Auxilliary components internal to engine                                     |
@@ -830,6 +1480,20 @@ namespace olc
 		uint32_t points = 0;
 	};
 
+	// A layer as the engine presents it, handed over from its olc::LayerDesc once OnUserUpdate() is done
+	struct LayerPresent
+	{
+		olc::vf2d vOffset = { 0, 0 };
+		olc::vf2d vScale = { 1, 1 };
+		bool bShow = false;
+		bool bUpdate = false;
+		olc::Pixel tint = olc::WHITE;
+		std::function<void()> funcHook = nullptr;
+		std::vector<DecalInstance> vecDecalInstance;
+		// Pipelined, the other half of the double buffered draw target, the half being presented
+		std::unique_ptr<olc::Sprite> pSprite;
+	};
+
 	struct LayerDesc
 	{
 		olc::vf2d vOffset = { 0, 0 };
@@ -841,6 +1505,7 @@ namespace olc
 		std::vector<DecalInstance> vecDecalInstance;
 		olc::Pixel tint = olc::WHITE;
 		std::function<void()> funcHook = nullptr;
+		LayerPresent present;
 	};
 
 	class Renderer
@@ -857,6 +1522,8 @@ namespace olc
 		virtual void       DrawDecal(const olc::DecalInstance& decal) = 0;
 		virtual uint32_t   CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true) = 0;
 		virtual void       UpdateTexture(uint32_t id, olc::Sprite* spr) = 0;
+		// Uploads the area pos to pos+size of spr to a texture of the same size
+		virtual void       UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) { UNUSED(pos); UNUSED(size); UpdateTexture(id, spr); }
 		virtual void       ReadTexture(uint32_t id, olc::Sprite* spr) = 0;
 		virtual uint32_t   DeleteTexture(const uint32_t id) = 0;
 		virtual void       ApplyTexture(uint32_t id) = 0;
@@ -878,6 +1545,10 @@ namespace olc
 		virtual olc::rcode SetWindowTitle(const std::string& s) = 0;
 		virtual olc::rcode StartSystemEventLoop() = 0;
 		virtual olc::rcode HandleSystemEvent() = 0;
+		// Blocks until there may be an event for HandleSystemEvent() or WakeSystemEvent() is called. Platforms
+		// whose events arrive on another thread return FAIL, and the engine waits for those itself
+		virtual olc::rcode WaitSystemEvent() { return olc::rcode::FAIL; }
+		virtual void WakeSystemEvent() {}
 		static olc::PixelGameEngine* ptrPGE;
 	};
 
@@ -897,8 +1568,11 @@ namespace olc
 		PixelGameEngine();
 		virtual ~PixelGameEngine();
 	public:
+		// Pipelined, OnUserUpdate() runs on a thread of its own, making the next frame while the engine
+		// thread presents the last. Layers are double buffered, so pointers into their pixels are only good
+		// for the frame. Decals, layers and the screen size can only be made and changed in OnUserCreate()
 		olc::rcode Construct(int32_t screen_w, int32_t screen_h, int32_t pixel_w, int32_t pixel_h,
-			bool full_screen = false, bool vsync = false, bool cohesion = false);
+			bool full_screen = false, bool vsync = false, bool cohesion = false, bool pipelined = false);
 		olc::rcode Start();
 
 	public: // User Override Interfaces
@@ -924,6 +1598,10 @@ namespace olc
 		int32_t GetMouseWheel() const;
 		// Get the mouse in window space
 		const olc::vi2d& GetWindowMouse() const;
+		// Get the input events applied for this frame, in the order they happened
+		const std::vector<olc::InputEvent>& GetInputEvents() const;
+		// Gets the seconds from the oldest input event of the last presented frame with input until it was presented
+		float GetInputLatency() const;
 		// Gets the mouse as a vector to keep Tarriest happy
 		const olc::vi2d& GetMousePos() const;
 
@@ -949,6 +1627,10 @@ namespace olc
 		uint32_t GetFPS() const;
 		// Gets last update of elapsed time
 		float GetElapsedTime() const;
+		// Gets the bytes of sprite data uploaded to textures in the last frame
+		uint64_t GetUploadBytes() const;
+		// Gets the seconds from the input of the last presented frame being read until it was presented
+		float GetFrameLatency() const;
 		// Gets Actual Window size
 		const olc::vi2d& GetWindowSize() const;
 		// Gets pixel scale
@@ -980,6 +1662,14 @@ namespace olc
 		void SetPixelMode(std::function<olc::Pixel(const int x, const int y, const olc::Pixel& pSource, const olc::Pixel& pDest)> pixelMode);
 		// Change the blend factor from between 0.0f to 1.0f;
 		void SetPixelBlend(float fBlend);
+		// Paces frames to at most this many per second, 0.0f runs them as fast as possible
+		void SetFrameRateLimit(float fFramesPerSecond);
+		// OnUserUpdate() is always given this elapsed time and frames are paced to it, 0.0f uses real time
+		void SetFixedTimeStep(float fTimeStep);
+		// In idle mode a frame is only made when there is input or RequestRedraw() was called
+		void SetIdleMode(bool bIdle);
+		// Asks for one more frame in idle mode, can be called from any thread
+		void RequestRedraw();
 
 
 
@@ -1008,6 +1698,12 @@ namespace olc
 		// Flat fills a triangle between points (x1,y1), (x2,y2) and (x3,y3)
 		void FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p = olc::WHITE);
 		void FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p = olc::WHITE);
+		// Fills the pixels (x1,y) to (x2,y) inclusive, nothing is drawn if x2 < x1. The span
+		// is clipped once, and in NORMAL and MASK pixel modes written directly to the draw target
+		// without going through Draw()
+		void FillSpanH(int32_t x1, int32_t x2, int32_t y, Pixel p = olc::WHITE);
+		// Fills the pixels (x,y1) to (x,y2) inclusive, nothing is drawn if y2 < y1
+		void FillSpanV(int32_t x, int32_t y1, int32_t y2, Pixel p = olc::WHITE);
 		// Draws an entire sprite at location (x,y)
 		void DrawSprite(int32_t x, int32_t y, Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE);
 		void DrawSprite(const olc::vi2d& pos, Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE);
@@ -1023,6 +1719,9 @@ namespace olc
 		void DrawStringProp(int32_t x, int32_t y, const std::string& sText, Pixel col = olc::WHITE, uint32_t scale = 1);
 		void DrawStringProp(const olc::vi2d& pos, const std::string& sText, Pixel col = olc::WHITE, uint32_t scale = 1);
 		olc::vi2d GetTextSizeProp(const std::string& s);
+		// A context with the current draw target, pixel mode and font, which can be drawn with
+		// from any thread. It does not follow later changes to the engine's state
+		olc::DrawContext GetDrawContext() const;
 
 		// Decal Quad functions
 		void SetDecalMode(const olc::DecalMode& mode);
@@ -1110,9 +1809,7 @@ namespace olc
 		olc::vi2d   vScreenPixelSize = { 4, 4 };
 		olc::vi2d	vMousePos = { 0, 0 };
 		int32_t		nMouseWheelDelta = 0;
-		olc::vi2d	vMousePosCache = { 0, 0 };
 		olc::vi2d   vMouseWindowPos = { 0, 0 };
-		int32_t		nMouseWheelDeltaCache = 0;
 		olc::vi2d	vWindowSize = { 0, 0 };
 		olc::vi2d	vViewPos = { 0, 0 };
 		olc::vi2d	vViewSize = { 0,0 };
@@ -1129,27 +1826,48 @@ namespace olc
 		std::vector<LayerDesc> vLayers;
 		uint8_t		nTargetLayer = 0;
 		uint32_t	nLastFPS = 0;
+		uint64_t	nUploadBytes = 0; // Counted by olc::Decal
+		std::atomic<uint64_t> nLastUploadBytes{ 0 };
+		friend class olc::Decal;
+		bool		bPipelined = false;
+		std::atomic<float> fLastLatency{ 0.0f };
+		uint64_t	nTotalUploadBytes = 0; // Run totals over every presented frame
+		double		fTotalLatency = 0.0;
+		uint32_t	nTotalPresented = 0;
+		friend class Platform_Headless;
+		std::atomic<float> fFrameRateLimit{ 0.0f };
+		std::atomic<float> fFixedTimeStep{ 0.0f };
+		std::atomic<bool> bIdleMode{ false };
+		std::atomic<bool> bAtomWake{ true };
+		std::mutex	muxWake;
+		std::condition_variable cvWake;
+		std::chrono::steady_clock::time_point tpNextFrame;
+		std::chrono::steady_clock::duration dSleepMargin = std::chrono::milliseconds(2);
 		bool        bPixelCohesion = false;
 		DecalMode   nDecalMode = DecalMode::NORMAL;
 		DecalStructure nDecalStructure = DecalStructure::FAN;
 		std::function<olc::Pixel(const int x, const int y, const olc::Pixel&, const olc::Pixel&)> funcPixelMode;
-		std::chrono::time_point<std::chrono::system_clock> m_tp1, m_tp2;
+		std::chrono::time_point<std::chrono::system_clock> m_tp1, m_tp2, m_tpPresent;
 		std::vector<olc::vi2d> vFontSpacing;
 
-		// State of keyboard		
-		bool		pKeyNewState[256] = { 0 };
-		bool		pKeyOldState[256] = { 0 };
+		// Input from the platform, applied at the start of each frame
+		InputQueue	inputQueue;
+		std::vector<olc::InputEvent> vFrameInput;
+		std::chrono::time_point<std::chrono::system_clock> m_tpPresentInput;
+		bool		bPresentInput = false;
+		std::atomic<float> fLastInputLatency{ 0.0f };
+
+		// State of keyboard
 		HWButton	pKeyboardState[256] = { 0 };
 
 		// State of mouse
-		bool		pMouseNewState[nMouseButtons] = { 0 };
-		bool		pMouseOldState[nMouseButtons] = { 0 };
 		HWButton	pMouseState[nMouseButtons] = { 0 };
 
 		// The main engine thread
 		void		EngineThread();
 
 
+
 		// If anything sets this flag to false, the engine
 		// "should" shut down gracefully
 		static std::atomic<bool> bAtomActive;
@@ -1162,6 +1880,14 @@ namespace olc
 		void olc_UpdateViewport();
 		void olc_ConstructFontSheet();
 		void olc_CoreUpdate();
+		void olc_PipelinedUpdate();
+		void olc_PaceFrame();
+		bool olc_SkipIdleFrame();
+		void olc_PushInput(InputEvent e);
+		void olc_Wake();
+		void olc_UpdateFrame();
+		void olc_HandOverFrame();
+		void olc_PresentFrame();
 		void olc_PrepareEngine();
 		void olc_UpdateMouseState(int32_t button, bool state);
 		void olc_UpdateKeyState(int32_t key, bool state);
@@ -1374,6 +2100,7 @@ namespace olc
 		if (x >= 0 && x < width && y >= 0 && y < height)
 		{
 			pColData[y * width + x] = p;
+			SetDirty(x, y, 1, 1);
 			return true;
 		}
 		else
@@ -1412,11 +2139,48 @@ namespace olc
 	Pixel* Sprite::GetData()
 	{ return pColData.data(); }
 
+	void Sprite::SetDirty()
+	{ SetDirty(0, 0, width, height); }
+
+	void Sprite::SetDirty(int32_t x, int32_t y, int32_t w, int32_t h)
+	{
+		if (w <= 0 || h <= 0) return;
+		// The area only grows until it is cleared, so the bounds need no lock between threads
+		auto Lower = [](std::atomic<int32_t>& a, int32_t v)
+		{ int32_t c = a.load(std::memory_order_relaxed); while (v < c && !a.compare_exchange_weak(c, v, std::memory_order_relaxed)); };
+		auto Raise = [](std::atomic<int32_t>& a, int32_t v)
+		{ int32_t c = a.load(std::memory_order_relaxed); while (v > c && !a.compare_exchange_weak(c, v, std::memory_order_relaxed)); };
+		Lower(nDirtyMinX, x); Lower(nDirtyMinY, y);
+		Raise(nDirtyMaxX, x + w); Raise(nDirtyMaxY, y + h);
+	}
+
+	void Sprite::ClearDirty()
+	{
+		nDirtyMinX = INT32_MAX; nDirtyMinY = INT32_MAX;
+		nDirtyMaxX = 0; nDirtyMaxY = 0;
+	}
+
+	bool Sprite::IsDirty() const
+	{ return GetDirtySize().x > 0; }
+
+	olc::vi2d Sprite::GetDirtyPos() const
+	{ return { std::max(nDirtyMinX.load(), 0), std::max(nDirtyMinY.load(), 0) }; }
+
+	olc::vi2d Sprite::GetDirtySize() const
+	{
+		const olc::vi2d pos = GetDirtyPos();
+		const int32_t ex = std::min(nDirtyMaxX.load(), width), ey = std::min(nDirtyMaxY.load(), height);
+		if (ex <= pos.x || ey <= pos.y) return { 0, 0 };
+		return { ex - pos.x, ey - pos.y };
+	}
+
 
 	olc::rcode Sprite::LoadFromFile(const std::string& sImageFile, olc::ResourcePack* pack)
 	{
 		UNUSED(pack);
-		return loader->LoadImageResource(this, sImageFile, pack);
+		const olc::rcode rc = loader->LoadImageResource(this, sImageFile, pack);
+		SetDirty();
+		return rc;
 	}
 
 	olc::Sprite* Sprite::Duplicate()
@@ -1460,6 +2224,19 @@ namespace olc
 		vUVScale = { 1.0f / float(sprite->width), 1.0f / float(sprite->height) };
 		renderer->ApplyTexture(id);
 		renderer->UpdateTexture(id, sprite);
+		renderer->ptrPGE->nUploadBytes += uint64_t(sprite->width) * uint64_t(sprite->height) * sizeof(olc::Pixel);
+		sprite->ClearDirty();
+	}
+
+	void Decal::UpdateDirty()
+	{
+		if (sprite == nullptr || !sprite->IsDirty()) return;
+		const olc::vi2d pos = sprite->GetDirtyPos(), size = sprite->GetDirtySize();
+		if (size.x == sprite->width && size.y == sprite->height) { Update(); return; }
+		renderer->ApplyTexture(id);
+		renderer->UpdateTextureRegion(id, sprite, pos, size);
+		renderer->ptrPGE->nUploadBytes += uint64_t(size.x) * uint64_t(size.y) * sizeof(olc::Pixel);
+		sprite->ClearDirty();
 	}
 
 	void Decal::UpdateSprite()
@@ -1682,28 +2459,236 @@ namespace olc
 	};
 
 	// O------------------------------------------------------------------------------O
-	// | olc::PixelGameEngine IMPLEMENTATION                                          |
+	// | olc::DrawContext IMPLEMENTATION                                              |
 	// O------------------------------------------------------------------------------O
-	PixelGameEngine::PixelGameEngine()
+	DrawContext::DrawContext(olc::Sprite* target, const olc::Sprite* font)
+		: pTarget(target), pFont(font)
 	{
-		sAppName = "Undefined";
-		olc::PGEX::pge = this;
+		if (target) vClipMax = { target->width, target->height };
+	}
 
-		// Bring in relevant Platform & Rendering systems depending
-		// on compiler parameters
-		olc_ConfigureSystem();
+	DrawContext DrawContext::Clip(int32_t x, int32_t y, int32_t w, int32_t h) const
+	{
+		DrawContext dc = *this;
+		dc.vClipMin = vClipMin.max({ x, y });
+		dc.vClipMax = vClipMax.min({ x + w, y + h }).max(dc.vClipMin);
+		return dc;
 	}
 
-	PixelGameEngine::~PixelGameEngine()
-	{}
+	DrawContext DrawContext::Clip(const olc::vi2d& pos, const olc::vi2d& size) const
+	{ return Clip(pos.x, pos.y, size.x, size.y); }
 
+	DrawContext DrawContext::WithPixelMode(Pixel::Mode m, float fBlend) const
+	{
+		DrawContext dc = *this;
+		dc.nPixelMode = m;
+		dc.fBlendFactor = std::min(1.0f, std::max(0.0f, fBlend));
+		return dc;
+	}
 
-	olc::rcode PixelGameEngine::Construct(int32_t screen_w, int32_t screen_h, int32_t pixel_w, int32_t pixel_h, bool full_screen, bool vsync, bool cohesion)
+	DrawContext DrawContext::WithPixelMode(std::function<olc::Pixel(const int x, const int y, const olc::Pixel& pSource, const olc::Pixel& pDest)> pixelMode) const
 	{
-		bPixelCohesion = cohesion;
-		vScreenSize = { screen_w, screen_h };
-		vInvScreenSize = { 1.0f / float(screen_w), 1.0f / float(screen_h) };
-		vPixelSize = { pixel_w, pixel_h };
+		DrawContext dc = *this;
+		dc.funcPixelMode = pixelMode;
+		dc.nPixelMode = Pixel::CUSTOM;
+		return dc;
+	}
+
+	olc::Sprite* DrawContext::GetTarget() const
+	{ return pTarget; }
+
+	olc::vi2d DrawContext::GetClipPos() const
+	{ return vClipMin; }
+
+	olc::vi2d DrawContext::GetClipSize() const
+	{ return vClipMax - vClipMin; }
+
+	Pixel::Mode DrawContext::GetPixelMode() const
+	{ return nPixelMode; }
+
+	bool DrawContext::Draw(const olc::vi2d& pos, Pixel p) const
+	{ return Draw(pos.x, pos.y, p); }
+
+	bool DrawContext::Draw(int32_t x, int32_t y, Pixel p) const
+	{
+		bool bDrawn = false;
+		Dispatch([&](const auto& blend) { bDrawn = Draw(blend, x, y, p); });
+		return bDrawn;
+	}
+
+	void DrawContext::DrawLine(const olc::vi2d& pos1, const olc::vi2d& pos2, Pixel p, uint32_t pattern) const
+	{ DrawLine(pos1.x, pos1.y, pos2.x, pos2.y, p, pattern); }
+
+	void DrawContext::DrawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p, uint32_t pattern) const
+	{ Dispatch([&](const auto& blend) { DrawLine(blend, x1, y1, x2, y2, p, pattern); }); }
+
+	void DrawContext::DrawCircle(const olc::vi2d& pos, int32_t radius, Pixel p, uint8_t mask) const
+	{ DrawCircle(pos.x, pos.y, radius, p, mask); }
+
+	void DrawContext::DrawCircle(int32_t x, int32_t y, int32_t radius, Pixel p, uint8_t mask) const
+	{ Dispatch([&](const auto& blend) { DrawCircle(blend, x, y, radius, p, mask); }); }
+
+	void DrawContext::FillCircle(const olc::vi2d& pos, int32_t radius, Pixel p) const
+	{ FillCircle(pos.x, pos.y, radius, p); }
+
+	void DrawContext::FillCircle(int32_t x, int32_t y, int32_t radius, Pixel p) const
+	{ Dispatch([&](const auto& blend) { FillCircle(blend, x, y, radius, p); }); }
+
+	void DrawContext::DrawRect(const olc::vi2d& pos, const olc::vi2d& size, Pixel p) const
+	{ DrawRect(pos.x, pos.y, size.x, size.y, p); }
+
+	void DrawContext::DrawRect(int32_t x, int32_t y, int32_t w, int32_t h, Pixel p) const
+	{
+		Dispatch([&](const auto& blend)
+		{
+			DrawLine(blend, x, y, x + w, y, p);
+			DrawLine(blend, x + w, y, x + w, y + h, p);
+			DrawLine(blend, x + w, y + h, x, y + h, p);
+			DrawLine(blend, x, y + h, x, y, p);
+		});
+	}
+
+	void DrawContext::FillRect(const olc::vi2d& pos, const olc::vi2d& size, Pixel p) const
+	{ FillRect(pos.x, pos.y, size.x, size.y, p); }
+
+	void DrawContext::FillRect(int32_t x, int32_t y, int32_t w, int32_t h, Pixel p) const
+	{ Dispatch([&](const auto& blend) { FillRect(blend, x, y, w, h, p); }); }
+
+	void DrawContext::DrawTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p) const
+	{ DrawTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p); }
+
+	void DrawContext::DrawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p) const
+	{
+		Dispatch([&](const auto& blend)
+		{
+			DrawLine(blend, x1, y1, x2, y2, p);
+			DrawLine(blend, x2, y2, x3, y3, p);
+			DrawLine(blend, x3, y3, x1, y1, p);
+		});
+	}
+
+	void DrawContext::FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p) const
+	{ FillTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p); }
+
+	void DrawContext::FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p) const
+	{ Dispatch([&](const auto& blend) { FillTriangle(blend, x1, y1, x2, y2, x3, y3, p); }); }
+
+	void DrawContext::FillSpanH(int32_t x1, int32_t x2, int32_t y, Pixel p) const
+	{ Dispatch([&](const auto& blend) { FillSpanH(blend, x1, x2, y, p); }); }
+
+	void DrawContext::FillSpanV(int32_t x, int32_t y1, int32_t y2, Pixel p) const
+	{ Dispatch([&](const auto& blend) { FillSpanV(blend, x, y1, y2, p); }); }
+
+	void DrawContext::DrawSprite(const olc::vi2d& pos, const Sprite* sprite, uint32_t scale, uint8_t flip) const
+	{ DrawSprite(pos.x, pos.y, sprite, scale, flip); }
+
+	void DrawContext::DrawSprite(int32_t x, int32_t y, const Sprite* sprite, uint32_t scale, uint8_t flip) const
+	{ Dispatch([&](const auto& blend) { DrawSprite(blend, x, y, sprite, scale, flip); }); }
+
+	void DrawContext::DrawPartialSprite(const olc::vi2d& pos, const Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip) const
+	{ DrawPartialSprite(pos.x, pos.y, sprite, sourcepos.x, sourcepos.y, size.x, size.y, scale, flip); }
+
+	void DrawContext::DrawPartialSprite(int32_t x, int32_t y, const Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip) const
+	{ Dispatch([&](const auto& blend) { DrawPartialSprite(blend, x, y, sprite, ox, oy, w, h, scale, flip); }); }
+
+	void DrawContext::DrawString(const olc::vi2d& pos, const std::string& sText, Pixel col, uint32_t scale) const
+	{ DrawString(pos.x, pos.y, sText, col, scale); }
+
+	void DrawContext::DrawString(int32_t x, int32_t y, const std::string& sText, Pixel col, uint32_t scale) const
+	{
+		if (pFont == nullptr)
+			return;
+
+		// As the engine, text is masked or blended unless a custom mode is set
+		const DrawContext text = nPixelMode == Pixel::CUSTOM ? *this : WithPixelMode(col.a != 255 ? Pixel::ALPHA : Pixel::MASK, fBlendFactor);
+
+		text.Dispatch([&](const auto& blend)
+		{
+			int32_t sx = 0;
+			int32_t sy = 0;
+			for (auto c : sText)
+			{
+				if (c == '\n')
+				{
+					sx = 0; sy += 8 * scale;
+				}
+				else if (c == '\t')
+				{
+					sx += 8 * nTabSizeInSpaces * scale;
+				}
+				else
+				{
+					int32_t ox = (c - 32) % 16;
+					int32_t oy = (c - 32) / 16;
+
+					for (uint32_t i = 0; i < 8; i++)
+						for (uint32_t j = 0; j < 8; j++)
+							if (pFont->GetPixel(i + ox * 8, j + oy * 8).r > 0)
+								text.FillRect(blend, x + sx + (i * scale), y + sy + (j * scale), scale, scale, col);
+					sx += 8 * scale;
+				}
+			}
+		});
+	}
+
+	void DrawContext::Clear(Pixel p) const
+	{
+		for (int32_t y = vClipMin.y; y < vClipMax.y; y++)
+			blend::Normal().Fill(pTarget->GetData() + y * pTarget->width + vClipMin.x, vClipMax.x - vClipMin.x, vClipMin.x, y, p);
+		pTarget->SetDirty(vClipMin.x, vClipMin.y, vClipMax.x - vClipMin.x, vClipMax.y - vClipMin.y);
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::InputQueue IMPLEMENTATION                                               |
+	// O------------------------------------------------------------------------------O
+	InputQueue::InputQueue() : vEvents(nCapacity)
+	{ }
+
+	bool InputQueue::Push(const InputEvent& e)
+	{
+		const uint32_t nWrite = nHead.load(std::memory_order_relaxed);
+		if (nWrite - nTail.load(std::memory_order_acquire) == nCapacity) return false;
+		vEvents[nWrite & (nCapacity - 1)] = e;
+		nHead.store(nWrite + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool InputQueue::Pop(InputEvent& e)
+	{
+		const uint32_t nRead = nTail.load(std::memory_order_relaxed);
+		if (nRead == nHead.load(std::memory_order_acquire)) return false;
+		e = vEvents[nRead & (nCapacity - 1)];
+		nTail.store(nRead + 1, std::memory_order_release);
+		return true;
+	}
+
+	uint32_t InputQueue::Size() const
+	{ return nHead.load(std::memory_order_acquire) - nTail.load(std::memory_order_acquire); }
+
+	// O------------------------------------------------------------------------------O
+	// | olc::PixelGameEngine IMPLEMENTATION                                          |
+	// O------------------------------------------------------------------------------O
+	PixelGameEngine::PixelGameEngine()
+	{
+		sAppName = "Undefined";
+		olc::PGEX::pge = this;
+
+		// Bring in relevant Platform & Rendering systems depending
+		// on compiler parameters
+		olc_ConfigureSystem();
+	}
+
+	PixelGameEngine::~PixelGameEngine()
+	{}
+
+
+	olc::rcode PixelGameEngine::Construct(int32_t screen_w, int32_t screen_h, int32_t pixel_w, int32_t pixel_h, bool full_screen, bool vsync, bool cohesion, bool pipelined)
+	{
+		bPixelCohesion = cohesion;
+		bPipelined = pipelined;
+		vScreenSize = { screen_w, screen_h };
+		vInvScreenSize = { 1.0f / float(screen_w), 1.0f / float(screen_h) };
+		vPixelSize = { pixel_w, pixel_h };
 		vWindowSize = vScreenSize * vPixelSize;
 		bFullScreen = full_screen;
 		bEnableVSYNC = vsync;
@@ -1863,6 +2848,12 @@ namespace olc
 	float PixelGameEngine::GetElapsedTime() const
 	{ return fLastElapsed; }
 
+	uint64_t PixelGameEngine::GetUploadBytes() const
+	{ return nLastUploadBytes; }
+
+	float PixelGameEngine::GetFrameLatency() const
+	{ return fLastLatency; }
+
 	const olc::vi2d& PixelGameEngine::GetWindowSize() const
 	{ return vWindowSize; }
 
@@ -1875,42 +2866,25 @@ namespace olc
 	const olc::vi2d& PixelGameEngine::GetWindowMouse() const
 	{ return vMouseWindowPos; }
 
+	const std::vector<olc::InputEvent>& PixelGameEngine::GetInputEvents() const
+	{ return vFrameInput; }
+
+	float PixelGameEngine::GetInputLatency() const
+	{ return fLastInputLatency; }
+
 	bool PixelGameEngine::Draw(const olc::vi2d& pos, Pixel p)
 	{ return Draw(pos.x, pos.y, p); }
 
 	// This is it, the critical function that plots a pixel
 	bool PixelGameEngine::Draw(int32_t x, int32_t y, Pixel p)
 	{
-		if (!pDrawTarget) return false;
-
-		if (nPixelMode == Pixel::NORMAL)
-		{
-			return pDrawTarget->SetPixel(x, y, p);
-		}
+		if (!pDrawTarget || x < 0 || y < 0 || x >= pDrawTarget->width || y >= pDrawTarget->height) return false;
 
-		if (nPixelMode == Pixel::MASK)
-		{
-			if (p.a == 255)
-				return pDrawTarget->SetPixel(x, y, p);
-		}
-
-		if (nPixelMode == Pixel::ALPHA)
-		{
-			Pixel d = pDrawTarget->GetPixel(x, y);
-			float a = (float)(p.a / 255.0f) * fBlendFactor;
-			float c = 1.0f - a;
-			float r = a * (float)p.r + c * (float)d.r;
-			float g = a * (float)p.g + c * (float)d.g;
-			float b = a * (float)p.b + c * (float)d.b;
-			return pDrawTarget->SetPixel(x, y, Pixel((uint8_t)r, (uint8_t)g, (uint8_t)b/*, (uint8_t)(p.a * fBlendFactor)*/));
-		}
-
-		if (nPixelMode == Pixel::CUSTOM)
-		{
-			return pDrawTarget->SetPixel(x, y, funcPixelMode(x, y, p, pDrawTarget->GetPixel(x, y)));
-		}
-
-		return false;
+		bool bDrawn = false;
+		Pixel& d = pDrawTarget->pColData[y * pDrawTarget->width + x];
+		blend::Dispatch(nPixelMode, fBlendFactor, funcPixelMode, [&](const auto& blend) { bDrawn = blend(x, y, p, d); });
+		if (bDrawn) pDrawTarget->SetDirty(x, y, 1, 1);
+		return bDrawn;
 	}
 
 
@@ -1919,87 +2893,7 @@ namespace olc
 
 	void PixelGameEngine::DrawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p, uint32_t pattern)
 	{
-		int x, y, dx, dy, dx1, dy1, px, py, xe, ye, i;
-		dx = x2 - x1; dy = y2 - y1;
-
-		auto rol = [&](void) { pattern = (pattern << 1) | (pattern >> 31); return pattern & 1; };
-
-		olc::vi2d p1(x1, y1), p2(x2, y2);
-		//if (!ClipLineToScreen(p1, p2))
-		//	return;
-		x1 = p1.x; y1 = p1.y;
-		x2 = p2.x; y2 = p2.y;
-
-		// straight lines idea by gurkanctn
-		if (dx == 0) // Line is vertical
-		{
-			if (y2 < y1) std::swap(y1, y2);
-			for (y = y1; y <= y2; y++) if (rol()) Draw(x1, y, p);
-			return;
-		}
-
-		if (dy == 0) // Line is horizontal
-		{
-			if (x2 < x1) std::swap(x1, x2);
-			for (x = x1; x <= x2; x++) if (rol()) Draw(x, y1, p);
-			return;
-		}
-
-		// Line is Funk-aye
-		dx1 = abs(dx); dy1 = abs(dy);
-		px = 2 * dy1 - dx1;	py = 2 * dx1 - dy1;
-		if (dy1 <= dx1)
-		{
-			if (dx >= 0)
-			{
-				x = x1; y = y1; xe = x2;
-			}
-			else
-			{
-				x = x2; y = y2; xe = x1;
-			}
-
-			if (rol()) Draw(x, y, p);
-
-			for (i = 0; x < xe; i++)
-			{
-				x = x + 1;
-				if (px < 0)
-					px = px + 2 * dy1;
-				else
-				{
-					if ((dx < 0 && dy < 0) || (dx > 0 && dy > 0)) y = y + 1; else y = y - 1;
-					px = px + 2 * (dy1 - dx1);
-				}
-				if (rol()) Draw(x, y, p);
-			}
-		}
-		else
-		{
-			if (dy >= 0)
-			{
-				x = x1; y = y1; ye = y2;
-			}
-			else
-			{
-				x = x2; y = y2; ye = y1;
-			}
-
-			if (rol()) Draw(x, y, p);
-
-			for (i = 0; y < ye; i++)
-			{
-				y = y + 1;
-				if (py <= 0)
-					py = py + 2 * dx1;
-				else
-				{
-					if ((dx < 0 && dy < 0) || (dx > 0 && dy > 0)) x = x + 1; else x = x - 1;
-					py = py + 2 * (dx1 - dy1);
-				}
-				if (rol()) Draw(x, y, p);
-			}
-		}
+		raster::Line(x1, y1, x2, y2, pattern, [&](int32_t x, int32_t y) { Draw(x, y, p); });
 	}
 
 	void PixelGameEngine::DrawCircle(const olc::vi2d& pos, int32_t radius, Pixel p, uint8_t mask)
@@ -2011,32 +2905,7 @@ namespace olc
 			return;
 
 		if (radius > 0)
-		{
-			int x0 = 0;
-			int y0 = radius;
-			int d = 3 - 2 * radius;
-
-			while (y0 >= x0) // only formulate 1/8 of circle
-			{
-				// Draw even octants
-				if (mask & 0x01) Draw(x + x0, y - y0, p);// Q6 - upper right right
-				if (mask & 0x04) Draw(x + y0, y + x0, p);// Q4 - lower lower right
-				if (mask & 0x10) Draw(x - x0, y + y0, p);// Q2 - lower left left
-				if (mask & 0x40) Draw(x - y0, y - x0, p);// Q0 - upper upper left
-				if (x0 != 0 && x0 != y0)
-				{
-					if (mask & 0x02) Draw(x + y0, y - x0, p);// Q7 - upper upper right
-					if (mask & 0x08) Draw(x + x0, y + y0, p);// Q5 - lower right right
-					if (mask & 0x20) Draw(x - y0, y + x0, p);// Q3 - lower lower left
-					if (mask & 0x80) Draw(x - x0, y - y0, p);// Q1 - upper left left
-				}
-
-				if (d < 0)
-					d += 4 * x0++ + 6;
-				else
-					d += 4 * (x0++ - y0--) + 10;
-			}
-		}
+			raster::Circle(x, y, radius, mask, [&](int32_t px, int32_t py) { Draw(px, py, p); });
 		else
 			Draw(x, y, p);
 	}
@@ -2050,35 +2919,7 @@ namespace olc
 			return;
 
 		if (radius > 0)
-		{
-			int x0 = 0;
-			int y0 = radius;
-			int d = 3 - 2 * radius;
-
-			auto drawline = [&](int sx, int ex, int y)
-			{
-				for (int x = sx; x <= ex; x++)
-					Draw(x, y, p);
-			};
-
-			while (y0 >= x0)
-			{
-				drawline(x - y0, x + y0, y - x0);
-				if (x0 > 0)	drawline(x - y0, x + y0, y + x0);
-
-				if (d < 0)
-					d += 4 * x0++ + 6;
-				else
-				{
-					if (x0 != y0)
-					{
-						drawline(x - x0, x + x0, y - y0);
-						drawline(x - x0, x + x0, y + y0);
-					}
-					d += 4 * (x0++ - y0--) + 10;
-				}
-			}
-		}
+			GetDrawContext().FillCircle(x, y, radius, p);
 		else
 			Draw(x, y, p);
 	}
@@ -2098,7 +2939,8 @@ namespace olc
 	{
 		int pixels = GetDrawTargetWidth() * GetDrawTargetHeight();
 		Pixel* m = GetDrawTarget()->GetData();
-		for (int i = 0; i < pixels; i++) m[i] = p;
+		blend::Normal().Fill(m, pixels, 0, 0, p);
+		GetDrawTarget()->SetDirty();
 	}
 
 	void PixelGameEngine::ClearBuffer(Pixel p, bool bDepth)
@@ -2107,6 +2949,12 @@ namespace olc
 	olc::Sprite* PixelGameEngine::GetFontSprite()
 	{ return fontSprite; }
 
+	olc::DrawContext PixelGameEngine::GetDrawContext() const
+	{
+		olc::DrawContext dc(pDrawTarget, fontSprite);
+		return nPixelMode == Pixel::CUSTOM ? dc.WithPixelMode(funcPixelMode) : dc.WithPixelMode(nPixelMode, fBlendFactor);
+	}
+
 	bool PixelGameEngine::ClipLineToScreen(olc::vi2d& in_p1, olc::vi2d& in_p2)
 	{
 		// https://en.wikipedia.org/wiki/Cohen%E2%80%93Sutherland_algorithm
@@ -2159,232 +3007,231 @@ namespace olc
 		if (y2 < 0) y2 = 0;
 		if (y2 >= (int32_t)GetDrawTargetHeight()) y2 = (int32_t)GetDrawTargetHeight();
 
-		for (int i = x; i < x2; i++)
+		if (!pDrawTarget || x2 <= x) return;
+
+		// Row by row, the rows are contiguous in memory and already clipped
+		blend::Dispatch(nPixelMode, fBlendFactor, funcPixelMode, [&](const auto& blend)
+		{
 			for (int j = y; j < y2; j++)
-				Draw(i, j, p);
+				blend.Fill(pDrawTarget->GetData() + j * pDrawTarget->width + x, x2 - x, x, j, p);
+		});
+		pDrawTarget->SetDirty(x, y, x2 - x, y2 - y);
 	}
 
-	void PixelGameEngine::DrawTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
-	{ DrawTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p); }
-
-	void PixelGameEngine::DrawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
+	void PixelGameEngine::FillSpanH(int32_t x1, int32_t x2, int32_t y, Pixel p)
 	{
-		DrawLine(x1, y1, x2, y2, p);
-		DrawLine(x2, y2, x3, y3, p);
-		DrawLine(x3, y3, x1, y1, p);
+		if (!pDrawTarget) return;
+		const int32_t w = pDrawTarget->width;
+		if (y < 0 || y >= pDrawTarget->height || x2 < 0 || x1 >= w || x2 < x1) return;
+		if (x1 < 0) x1 = 0;
+		if (x2 >= w) x2 = w - 1;
+
+		blend::Dispatch(nPixelMode, fBlendFactor, funcPixelMode, [&](const auto& blend)
+		{ blend.Fill(pDrawTarget->GetData() + y * w + x1, x2 - x1 + 1, x1, y, p); });
+		pDrawTarget->SetDirty(x1, y, x2 - x1 + 1, 1);
 	}
 
-	void PixelGameEngine::FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
-	{ FillTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p); }
-
-	// https://www.avrfreaks.net/sites/default/files/triangles.c
-	void PixelGameEngine::FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
+	void PixelGameEngine::FillSpanV(int32_t x, int32_t y1, int32_t y2, Pixel p)
 	{
-		auto drawline = [&](int sx, int ex, int ny) { for (int i = sx; i <= ex; i++) Draw(i, ny, p); };
-
-		int t1x, t2x, y, minx, maxx, t1xp, t2xp;
-		bool changed1 = false;
-		bool changed2 = false;
-		int signx1, signx2, dx1, dy1, dx2, dy2;
-		int e1, e2;
-		// Sort vertices
-		if (y1 > y2) { std::swap(y1, y2); std::swap(x1, x2); }
-		if (y1 > y3) { std::swap(y1, y3); std::swap(x1, x3); }
-		if (y2 > y3) { std::swap(y2, y3); std::swap(x2, x3); }
-
-		t1x = t2x = x1; y = y1;   // Starting points
-		dx1 = (int)(x2 - x1);
-		if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
-		else signx1 = 1;
-		dy1 = (int)(y2 - y1);
-
-		dx2 = (int)(x3 - x1);
-		if (dx2 < 0) { dx2 = -dx2; signx2 = -1; }
-		else signx2 = 1;
-		dy2 = (int)(y3 - y1);
-
-		if (dy1 > dx1) { std::swap(dx1, dy1); changed1 = true; }
-		if (dy2 > dx2) { std::swap(dy2, dx2); changed2 = true; }
-
-		e2 = (int)(dx2 >> 1);
-		// Flat top, just process the second half
-		if (y1 == y2) goto next;
-		e1 = (int)(dx1 >> 1);
-
-		for (int i = 0; i < dx1;) {
-			t1xp = 0; t2xp = 0;
-			if (t1x < t2x) { minx = t1x; maxx = t2x; }
-			else { minx = t2x; maxx = t1x; }
-			// process first line until y value is about to change
-			while (i < dx1) {
-				i++;
-				e1 += dy1;
-				while (e1 >= dx1) {
-					e1 -= dx1;
-					if (changed1) t1xp = signx1;//t1x += signx1;
-					else          goto next1;
-				}
-				if (changed1) break;
-				else t1x += signx1;
-			}
-			// Move line
-		next1:
-			// process second line until y value is about to change
-			while (1) {
-				e2 += dy2;
-				while (e2 >= dx2) {
-					e2 -= dx2;
-					if (changed2) t2xp = signx2;//t2x += signx2;
-					else          goto next2;
-				}
-				if (changed2)     break;
-				else              t2x += signx2;
-			}
-		next2:
-			if (minx > t1x) minx = t1x;
-			if (minx > t2x) minx = t2x;
-			if (maxx < t1x) maxx = t1x;
-			if (maxx < t2x) maxx = t2x;
-			drawline(minx, maxx, y);    // Draw line from min to max points found on the y
-										// Now increase y
-			if (!changed1) t1x += signx1;
-			t1x += t1xp;
-			if (!changed2) t2x += signx2;
-			t2x += t2xp;
-			y += 1;
-			if (y == y2) break;
-		}
-	next:
-		// Second half
-		dx1 = (int)(x3 - x2); if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
-		else signx1 = 1;
-		dy1 = (int)(y3 - y2);
-		t1x = x2;
-
-		if (dy1 > dx1) {   // swap values
-			std::swap(dy1, dx1);
-			changed1 = true;
-		}
-		else changed1 = false;
-
-		e1 = (int)(dx1 >> 1);
-
-		for (int i = 0; i <= dx1; i++) {
-			t1xp = 0; t2xp = 0;
-			if (t1x < t2x) { minx = t1x; maxx = t2x; }
-			else { minx = t2x; maxx = t1x; }
-			// process first line until y value is about to change
-			while (i < dx1) {
-				e1 += dy1;
-				while (e1 >= dx1) {
-					e1 -= dx1;
-					if (changed1) { t1xp = signx1; break; }//t1x += signx1;
-					else          goto next3;
-				}
-				if (changed1) break;
-				else   	   	  t1x += signx1;
-				if (i < dx1) i++;
-			}
-		next3:
-			// process second line until y value is about to change
-			while (t2x != x3) {
-				e2 += dy2;
-				while (e2 >= dx2) {
-					e2 -= dx2;
-					if (changed2) t2xp = signx2;
-					else          goto next4;
-				}
-				if (changed2)     break;
-				else              t2x += signx2;
-			}
-		next4:
-
-			if (minx > t1x) minx = t1x;
-			if (minx > t2x) minx = t2x;
-			if (maxx < t1x) maxx = t1x;
-			if (maxx < t2x) maxx = t2x;
-			drawline(minx, maxx, y);
-			if (!changed1) t1x += signx1;
-			t1x += t1xp;
-			if (!changed2) t2x += signx2;
-			t2x += t2xp;
-			y += 1;
-			if (y > y3) return;
-		}
+		if (!pDrawTarget) return;
+		const int32_t w = pDrawTarget->width;
+		if (x < 0 || x >= w || y2 < 0 || y1 >= pDrawTarget->height || y2 < y1) return;
+		if (y1 < 0) y1 = 0;
+		if (y2 >= pDrawTarget->height) y2 = pDrawTarget->height - 1;
+
+		blend::Dispatch(nPixelMode, fBlendFactor, funcPixelMode, [&](const auto& blend)
+		{
+			Pixel* m = pDrawTarget->GetData() + y1 * w + x;
+			for (int32_t y = y1; y <= y2; y++, m += w) blend(x, y, p, *m);
+		});
+		pDrawTarget->SetDirty(x, y1, 1, y2 - y1 + 1);
 	}
 
-	void PixelGameEngine::DrawSprite(const olc::vi2d& pos, Sprite* sprite, uint32_t scale, uint8_t flip)
-	{ DrawSprite(pos.x, pos.y, sprite, scale, flip); }
-
-	void PixelGameEngine::DrawSprite(int32_t x, int32_t y, Sprite* sprite, uint32_t scale, uint8_t flip)
+	void blend::Normal::Fill(Pixel* pDst, int32_t nCount, int32_t, int32_t, Pixel p) const
 	{
-		if (sprite == nullptr)
-			return;
+		int32_t i = 0;
+#if defined(OLC_SIMD_AVX2)
+		const __m256i v8 = _mm256_set1_epi32(int32_t(p.n));
+		for (; i + 8 <= nCount; i += 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), v8);
+#endif
+#if defined(OLC_SIMD_SSE2)
+		const __m128i v4 = _mm_set1_epi32(int32_t(p.n));
+		for (; i + 4 <= nCount; i += 4) _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), v4);
+#endif
+		for (; i < nCount; i++) pDst[i] = p;
+	}
+
+	void blend::Normal::Copy(Pixel* pDst, const Pixel* pSrc, int32_t nCount, int32_t, int32_t) const
+	{ std::copy(pSrc, pSrc + nCount, pDst); }
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = sprite->width - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = sprite->height - 1; fym = -1; }
+	void blend::Mask::Fill(Pixel* pDst, int32_t nCount, int32_t x, int32_t y, Pixel p) const
+	{ if (p.a == 255) Normal().Fill(pDst, nCount, x, y, p); }
 
-		if (scale > 1)
+	void blend::Mask::Copy(Pixel* pDst, const Pixel* pSrc, int32_t nCount, int32_t, int32_t) const
+	{
+		// Selects the opaque source pixels without a branch per pixel
+		int32_t i = 0;
+#if defined(OLC_SIMD_AVX2)
+		const __m256i opaque8 = _mm256_set1_epi32(0xFF);
+		for (; i + 8 <= nCount; i += 8)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx, fy));
-			}
+			const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+			const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pDst + i));
+			const __m256i m = _mm256_cmpeq_epi32(_mm256_srli_epi32(s, 24), opaque8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_blendv_epi8(d, s, m));
 		}
-		else
+#endif
+#if defined(OLC_SIMD_SSE2)
+		const __m128i opaque = _mm_set1_epi32(0xFF);
+		for (; i + 4 <= nCount; i += 4)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx, fy));
-			}
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + i));
+			const __m128i m = _mm_cmpeq_epi32(_mm_srli_epi32(s, 24), opaque);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, d)));
 		}
+#endif
+		for (; i < nCount; i++) if (pSrc[i].a == 255) pDst[i] = pSrc[i];
 	}
 
-	void PixelGameEngine::DrawPartialSprite(const olc::vi2d& pos, Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip)
-	{ DrawPartialSprite(pos.x, pos.y, sprite, sourcepos.x, sourcepos.y, size.x, size.y, scale, flip); }
-
-	void PixelGameEngine::DrawPartialSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
+#if defined(OLC_SIMD_SSE2)
+	namespace simd
 	{
-		if (sprite == nullptr)
-			return;
+		// x / 255 for the 16 bit lanes, exact for every x below 65535
+		inline __m128i Div255(__m128i x)
+		{ return _mm_srli_epi16(_mm_add_epi16(x, _mm_add_epi16(_mm_set1_epi16(1), _mm_srli_epi16(x, 8))), 8); }
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = w - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = h - 1; fym = -1; }
+		// Blends the colours widened to 16 bits, a holds the alpha of each pixel in all four lanes
+		inline __m128i Blend16(__m128i s, __m128i d, __m128i a)
+		{ return Div255(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(255), a)))); }
 
-		if (scale > 1)
+		// Alpha of four pixels times the blend factor, spread over the lanes of each pixel
+		inline void Alpha16(__m128i s, __m128i blend, __m128i& lo, __m128i& hi)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx + ox, fy + oy));
-			}
+			__m128i a = _mm_srli_epi32(s, 24);
+			a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+			a = Div255(_mm_add_epi16(_mm_mullo_epi16(a, blend), _mm_set1_epi16(127)));
+			lo = _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 1, 0, 0));
+			hi = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 2, 2));
 		}
-		else
-		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx + ox, fy + oy));
-			}
+
+#if defined(OLC_SIMD_AVX2)
+		inline __m256i Div255(__m256i x)
+		{ return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_add_epi16(_mm256_set1_epi16(1), _mm256_srli_epi16(x, 8))), 8); }
+
+		inline __m256i Blend16(__m256i s, __m256i d, __m256i a)
+		{ return Div255(_mm256_add_epi16(_mm256_mullo_epi16(s, a), _mm256_mullo_epi16(d, _mm256_sub_epi16(_mm256_set1_epi16(255), a)))); }
+
+		inline void Alpha16(__m256i s, __m256i blend, __m256i& lo, __m256i& hi)
+		{
+			__m256i a = _mm256_srli_epi32(s, 24);
+			a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+			a = Div255(_mm256_add_epi16(_mm256_mullo_epi16(a, blend), _mm256_set1_epi16(127)));
+			lo = _mm256_shuffle_epi32(a, _MM_SHUFFLE(1, 1, 0, 0));
+			hi = _mm256_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 2, 2));
+		}
+#endif
+	}
+#endif
+
+	void blend::Alpha::Fill(Pixel* pDst, int32_t nCount, int32_t, int32_t, Pixel p) const
+	{
+		int32_t i = 0;
+#if defined(OLC_SIMD_SSE2)
+		const uint16_t a = uint16_t((p.a * nBlend + 127) / 255);
+		const __m128i zero = _mm_setzero_si128(), opaque = _mm_set1_epi32(int32_t(nDefaultPixel));
+		const __m128i s4 = _mm_unpacklo_epi8(_mm_set1_epi32(int32_t(p.n)), zero), a4 = _mm_set1_epi16(int16_t(a));
+#if defined(OLC_SIMD_AVX2)
+		const __m256i zero8 = _mm256_setzero_si256(), opaque8 = _mm256_set1_epi32(int32_t(nDefaultPixel));
+		const __m256i s8 = _mm256_unpacklo_epi8(_mm256_set1_epi32(int32_t(p.n)), zero8), a8 = _mm256_set1_epi16(int16_t(a));
+		for (; i + 8 <= nCount; i += 8)
+		{
+			const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pDst + i));
+			const __m256i lo = simd::Blend16(s8, _mm256_unpacklo_epi8(d, zero8), a8);
+			const __m256i hi = simd::Blend16(s8, _mm256_unpackhi_epi8(d, zero8), a8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_or_si256(_mm256_packus_epi16(lo, hi), opaque8));
 		}
+#endif
+		for (; i + 4 <= nCount; i += 4)
+		{
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + i));
+			const __m128i lo = simd::Blend16(s4, _mm_unpacklo_epi8(d, zero), a4);
+			const __m128i hi = simd::Blend16(s4, _mm_unpackhi_epi8(d, zero), a4);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_or_si128(_mm_packus_epi16(lo, hi), opaque));
+		}
+#endif
+		for (; i < nCount; i++) pDst[i] = Blend(pDst[i], p, nBlend);
+	}
+
+	void blend::Alpha::Copy(Pixel* pDst, const Pixel* pSrc, int32_t nCount, int32_t, int32_t) const
+	{
+		int32_t i = 0;
+#if defined(OLC_SIMD_SSE2)
+		const __m128i zero = _mm_setzero_si128(), opaque = _mm_set1_epi32(int32_t(nDefaultPixel)), blend = _mm_set1_epi16(int16_t(nBlend));
+#if defined(OLC_SIMD_AVX2)
+		const __m256i zero8 = _mm256_setzero_si256(), opaque8 = _mm256_set1_epi32(int32_t(nDefaultPixel)), blend8 = _mm256_set1_epi16(int16_t(nBlend));
+		for (; i + 8 <= nCount; i += 8)
+		{
+			const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+			const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pDst + i));
+			__m256i alo, ahi;
+			simd::Alpha16(s, blend8, alo, ahi);
+			const __m256i lo = simd::Blend16(_mm256_unpacklo_epi8(s, zero8), _mm256_unpacklo_epi8(d, zero8), alo);
+			const __m256i hi = simd::Blend16(_mm256_unpackhi_epi8(s, zero8), _mm256_unpackhi_epi8(d, zero8), ahi);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_or_si256(_mm256_packus_epi16(lo, hi), opaque8));
+		}
+#endif
+		for (; i + 4 <= nCount; i += 4)
+		{
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + i));
+			__m128i alo, ahi;
+			simd::Alpha16(s, blend, alo, ahi);
+			const __m128i lo = simd::Blend16(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), alo);
+			const __m128i hi = simd::Blend16(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), ahi);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_or_si128(_mm_packus_epi16(lo, hi), opaque));
+		}
+#endif
+		for (; i < nCount; i++) pDst[i] = Blend(pDst[i], pSrc[i], nBlend);
+	}
+
+	void PixelGameEngine::DrawTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
+	{ DrawTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p); }
+
+	void PixelGameEngine::DrawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
+	{
+		DrawLine(x1, y1, x2, y2, p);
+		DrawLine(x2, y2, x3, y3, p);
+		DrawLine(x3, y3, x1, y1, p);
+	}
+
+	void PixelGameEngine::FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
+	{ FillTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p); }
+
+	void PixelGameEngine::FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
+	{
+		if (pDrawTarget) GetDrawContext().FillTriangle(x1, y1, x2, y2, x3, y3, p);
+	}
+
+	void PixelGameEngine::DrawSprite(const olc::vi2d& pos, Sprite* sprite, uint32_t scale, uint8_t flip)
+	{ DrawSprite(pos.x, pos.y, sprite, scale, flip); }
+
+	void PixelGameEngine::DrawSprite(int32_t x, int32_t y, Sprite* sprite, uint32_t scale, uint8_t flip)
+	{
+		// Rows at a time, with the pixel mode looked at once rather than by Draw() per pixel
+		if (sprite == nullptr || !pDrawTarget)
+			return;
+		GetDrawContext().DrawSprite(x, y, sprite, scale, flip);
+	}
+
+	void PixelGameEngine::DrawPartialSprite(const olc::vi2d& pos, Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip)
+	{ DrawPartialSprite(pos.x, pos.y, sprite, sourcepos.x, sourcepos.y, size.x, size.y, scale, flip); }
+
+	void PixelGameEngine::DrawPartialSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
+	{
+		if (sprite == nullptr || !pDrawTarget)
+			return;
+		GetDrawContext().DrawPartialSprite(x, y, sprite, ox, oy, w, h, scale, flip);
 	}
 
 	void PixelGameEngine::SetDecalMode(const olc::DecalMode& mode)
@@ -3004,6 +3851,18 @@ namespace olc
 		if (fBlendFactor > 1.0f) fBlendFactor = 1.0f;
 	}
 
+	void PixelGameEngine::SetFrameRateLimit(float fFramesPerSecond)
+	{ fFrameRateLimit = std::max(fFramesPerSecond, 0.0f); }
+
+	void PixelGameEngine::SetFixedTimeStep(float fTimeStep)
+	{ fFixedTimeStep = std::max(fTimeStep, 0.0f); }
+
+	void PixelGameEngine::SetIdleMode(bool bIdle)
+	{ bIdleMode = bIdle; }
+
+	void PixelGameEngine::RequestRedraw()
+	{ olc_Wake(); }
+
 	// User must override these functions as required. I have not made
 	// them abstract because I do need a default behaviour to occur if
 	// they are not overwritten
@@ -3047,39 +3906,70 @@ namespace olc
 	{
 		vWindowSize = { x, y };
 		olc_UpdateViewport();
+		olc_Wake();
 	}
 
 	void PixelGameEngine::olc_UpdateMouseWheel(int32_t delta)
-	{ nMouseWheelDeltaCache += delta; }
+	{
+		InputEvent e; e.type = InputEvent::Type::MOUSE_WHEEL; e.nCode = delta;
+		olc_PushInput(e);
+	}
 
 	void PixelGameEngine::olc_UpdateMouse(int32_t x, int32_t y)
 	{
 		// Mouse coords come in screen space
 		// But leave in pixel space
-		bHasMouseFocus = true;
-		vMouseWindowPos = { x, y };
+		InputEvent e; e.type = InputEvent::Type::MOUSE_MOVE;
+		e.wx = x; e.wy = y;
 		// Full Screen mode may have a weird viewport we must clamp to
 		x -= vViewPos.x;
 		y -= vViewPos.y;
-		vMousePosCache.x = (int32_t)(((float)x / (float)(vWindowSize.x - (vViewPos.x * 2)) * (float)vScreenSize.x));
-		vMousePosCache.y = (int32_t)(((float)y / (float)(vWindowSize.y - (vViewPos.y * 2)) * (float)vScreenSize.y));
-		if (vMousePosCache.x >= (int32_t)vScreenSize.x)	vMousePosCache.x = vScreenSize.x - 1;
-		if (vMousePosCache.y >= (int32_t)vScreenSize.y)	vMousePosCache.y = vScreenSize.y - 1;
-		if (vMousePosCache.x < 0) vMousePosCache.x = 0;
-		if (vMousePosCache.y < 0) vMousePosCache.y = 0;
+		e.x = (int32_t)(((float)x / (float)(vWindowSize.x - (vViewPos.x * 2)) * (float)vScreenSize.x));
+		e.y = (int32_t)(((float)y / (float)(vWindowSize.y - (vViewPos.y * 2)) * (float)vScreenSize.y));
+		if (e.x >= (int32_t)vScreenSize.x)	e.x = vScreenSize.x - 1;
+		if (e.y >= (int32_t)vScreenSize.y)	e.y = vScreenSize.y - 1;
+		if (e.x < 0) e.x = 0;
+		if (e.y < 0) e.y = 0;
+		olc_PushInput(e);
 	}
 
 	void PixelGameEngine::olc_UpdateMouseState(int32_t button, bool state)
-	{ pMouseNewState[button] = state; }
+	{
+		InputEvent e; e.type = InputEvent::Type::MOUSE_BUTTON; e.nCode = button; e.bState = state;
+		olc_PushInput(e);
+	}
 
 	void PixelGameEngine::olc_UpdateKeyState(int32_t key, bool state)
-	{ pKeyNewState[key] = state; }
+	{
+		InputEvent e; e.type = InputEvent::Type::KEY; e.nCode = key; e.bState = state;
+		olc_PushInput(e);
+	}
 
 	void PixelGameEngine::olc_UpdateMouseFocus(bool state)
-	{ bHasMouseFocus = state; }
+	{
+		InputEvent e; e.type = InputEvent::Type::MOUSE_FOCUS; e.bState = state;
+		olc_PushInput(e);
+	}
 
 	void PixelGameEngine::olc_UpdateKeyFocus(bool state)
-	{ bHasInputFocus = state; }
+	{
+		InputEvent e; e.type = InputEvent::Type::KEY_FOCUS; e.bState = state;
+		olc_PushInput(e);
+	}
+
+	void PixelGameEngine::olc_PushInput(InputEvent e)
+	{
+		// When the engine falls behind, moves give way first, as the next move says where the mouse is
+		// anyway, then presses and wheel turns. The last quarter is kept for releases and focus changes,
+		// so a key is not left held because its release found the queue full
+		uint32_t nLimit = InputQueue::nCapacity;
+		if (e.type == InputEvent::Type::MOUSE_MOVE) nLimit = InputQueue::nCapacity / 2;
+		else if (e.type == InputEvent::Type::MOUSE_WHEEL || ((e.type == InputEvent::Type::KEY || e.type == InputEvent::Type::MOUSE_BUTTON) && e.bState))
+			nLimit = InputQueue::nCapacity / 4 * 3;
+		e.tpTime = std::chrono::system_clock::now();
+		if (inputQueue.Size() < nLimit) inputQueue.Push(e);
+		olc_Wake();
+	}
 
 	void PixelGameEngine::olc_Reanimate()
 	{ bAtomActive = true; }
@@ -3088,7 +3978,16 @@ namespace olc
 	{ return bAtomActive; }
 
 	void PixelGameEngine::olc_Terminate()
-	{ bAtomActive = false; }
+	{ bAtomActive = false; olc_Wake(); }
+
+	void PixelGameEngine::olc_Wake()
+	{
+		// Only an idle engine can be asleep, and only if no frame is due yet
+		if (bAtomWake) return;
+		{ std::lock_guard<std::mutex> lock(muxWake); bAtomWake = true; }
+		cvWake.notify_one();
+		platform->WakeSystemEvent();
+	}
 
 	void PixelGameEngine::EngineThread()
 	{
@@ -3106,8 +4005,11 @@ namespace olc
 
 		while (bAtomActive)
 		{
-			// Run as fast as possible
-			while (bAtomActive) { olc_CoreUpdate(); }
+			// Run as fast as allowed
+			if (bPipelined)
+				olc_PipelinedUpdate();
+			else
+				while (bAtomActive) { olc_PaceFrame(); olc_CoreUpdate(); }
 
 			// Allow the user to free resources if they have overrided the destroy function
 			if (!OnUserDestroy())
@@ -3140,50 +4042,158 @@ namespace olc
 
 
 	void PixelGameEngine::olc_CoreUpdate()
+	{
+		// Some platforms will need to check for events
+		platform->HandleSystemEvent();
+
+		if (olc_SkipIdleFrame()) return;
+
+		olc_UpdateFrame();
+		olc_HandOverFrame();
+		olc_PresentFrame();
+	}
+
+	void PixelGameEngine::olc_PipelinedUpdate()
+	{
+		// The engine thread keeps the graphics context and the platform, so it presents and handles
+		// events, while the updater makes the next frame. They meet to hand each frame over
+		std::mutex muxFrame;
+		std::condition_variable cvFrame;
+		bool bUpdating = false, bStop = false;
+
+		std::thread updater([&]()
+		{
+			std::unique_lock<std::mutex> lock(muxFrame);
+			while (true)
+			{
+				cvFrame.wait(lock, [&] { return bUpdating || bStop; });
+				if (bStop) return;
+				lock.unlock();
+				olc_UpdateFrame();
+				lock.lock();
+				bUpdating = false;
+				cvFrame.notify_all();
+			}
+		});
+
+		bool bPresent = false;
+		while (bAtomActive)
+		{
+			// An idle engine shows the frame it has before it goes to sleep
+			if (bIdleMode && bPresent && !bAtomWake) { olc_PresentFrame(); bPresent = false; }
+
+			olc_PaceFrame();
+			platform->HandleSystemEvent();
+			if (olc_SkipIdleFrame()) continue;
+
+			{ std::lock_guard<std::mutex> lock(muxFrame); bUpdating = true; }
+			cvFrame.notify_all();
+
+			if (bPresent) olc_PresentFrame();
+
+			{
+				std::unique_lock<std::mutex> lock(muxFrame);
+				cvFrame.wait(lock, [&] { return !bUpdating; });
+			}
+
+			olc_HandOverFrame();
+			bPresent = true;
+		}
+
+		// Every frame made is presented
+		if (bPresent) olc_PresentFrame();
+
+		{ std::lock_guard<std::mutex> lock(muxFrame); bStop = true; }
+		cvFrame.notify_all();
+		updater.join();
+	}
+
+	bool PixelGameEngine::olc_SkipIdleFrame()
+	{
+		// In idle mode a frame is only made for input or a requested redraw. A skipped frame's
+		// time is not handed on either, or the next frame would make up for the whole idle spell
+		if (!bIdleMode || !bAtomActive || bAtomWake.exchange(false)) return false;
+		m_tp1 = std::chrono::system_clock::now();
+		return true;
+	}
+
+	void PixelGameEngine::olc_PaceFrame()
+	{
+		// Sleep until there is input or a frame is asked for. A platform that gets its events
+		// on this thread waits for them itself, otherwise they wake the engine as they arrive
+		if (bIdleMode && bAtomActive && !bAtomWake)
+		{
+			if (platform->WaitSystemEvent() != olc::rcode::OK)
+			{
+				std::unique_lock<std::mutex> lock(muxWake);
+				cvWake.wait(lock, [&] { return bAtomWake || !bAtomActive; });
+			}
+			// The time asleep is not elapsed time for the next frame
+			m_tp1 = std::chrono::system_clock::now();
+		}
+
+		const float fStep = fFixedTimeStep, fLimit = fFrameRateLimit;
+		const float fInterval = fStep > 0.0f ? fStep : (fLimit > 0.0f ? 1.0f / fLimit : 0.0f);
+		if (fInterval <= 0.0f) return;
+
+		// Sleep most of the way, the scheduler can wake us late, then spin for the rest. The margin
+		// follows how late recent sleeps were, so the spin is as short as this system allows
+		const auto dInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(fInterval));
+		auto tpNow = std::chrono::steady_clock::now();
+		if (tpNow < tpNextFrame)
+		{
+			if (tpNextFrame - tpNow > dSleepMargin)
+			{
+				const auto tpWake = tpNextFrame - dSleepMargin;
+				std::this_thread::sleep_until(tpWake);
+				const auto dLate = std::chrono::steady_clock::now() - tpWake;
+				dSleepMargin = std::min(std::max(dLate * 2, dSleepMargin - dSleepMargin / 16), dInterval / 2);
+			}
+			while ((tpNow = std::chrono::steady_clock::now()) < tpNextFrame) std::this_thread::yield();
+		}
+
+		// A late frame starts the schedule again rather than rushing the next ones to catch up
+		tpNextFrame = (tpNow - tpNextFrame < dInterval) ? tpNextFrame + dInterval : tpNow + dInterval;
+	}
+
+	void PixelGameEngine::olc_UpdateFrame()
 	{
 		// Handle Timing
 		m_tp2 = std::chrono::system_clock::now();
 		std::chrono::duration<float> elapsedTime = m_tp2 - m_tp1;
 		m_tp1 = m_tp2;
 
-		// Our time per frame coefficient
-		float fElapsedTime = elapsedTime.count();
+		// Our time per frame coefficient, a fixed time step stands in for it
+		float fElapsedTime = fFixedTimeStep > 0.0f ? fFixedTimeStep.load() : elapsedTime.count();
 		fLastElapsed = fElapsedTime;
+		fFrameTimer += elapsedTime.count();
 
-		// Some platforms will need to check for events
-		platform->HandleSystemEvent();
+		// Apply the input events in the order they happened, so a key pressed and released
+		// between two frames is both. Events arriving meanwhile are left for the next frame
+		for (auto& k : pKeyboardState) { k.bPressed = false; k.bReleased = false; }
+		for (auto& m : pMouseState) { m.bPressed = false; m.bReleased = false; }
+		auto SetButton = [](HWButton& b, bool bState)
+		{
+			if (bState) { b.bPressed |= !b.bHeld; b.bHeld = true; }
+			else { b.bReleased |= b.bHeld; b.bHeld = false; }
+		};
 
-		// Compare hardware input states from previous frame
-		auto ScanHardware = [&](HWButton* pKeys, bool* pStateOld, bool* pStateNew, uint32_t nKeyCount)
+		nMouseWheelDelta = 0;
+		vFrameInput.clear();
+		InputEvent e;
+		for (uint32_t nEvents = inputQueue.Size(); nEvents > 0 && inputQueue.Pop(e); nEvents--)
 		{
-			for (uint32_t i = 0; i < nKeyCount; i++)
+			switch (e.type)
 			{
-				pKeys[i].bPressed = false;
-				pKeys[i].bReleased = false;
-				if (pStateNew[i] != pStateOld[i])
-				{
-					if (pStateNew[i])
-					{
-						pKeys[i].bPressed = !pKeys[i].bHeld;
-						pKeys[i].bHeld = true;
-					}
-					else
-					{
-						pKeys[i].bReleased = true;
-						pKeys[i].bHeld = false;
-					}
-				}
-				pStateOld[i] = pStateNew[i];
+			case InputEvent::Type::KEY: if (e.nCode >= 0 && e.nCode < 256) SetButton(pKeyboardState[e.nCode], e.bState); break;
+			case InputEvent::Type::MOUSE_BUTTON: if (e.nCode >= 0 && e.nCode < nMouseButtons) SetButton(pMouseState[e.nCode], e.bState); break;
+			case InputEvent::Type::MOUSE_MOVE: vMousePos = { e.x, e.y }; vMouseWindowPos = { e.wx, e.wy }; bHasMouseFocus = true; break;
+			case InputEvent::Type::MOUSE_WHEEL: nMouseWheelDelta += e.nCode; break;
+			case InputEvent::Type::KEY_FOCUS: bHasInputFocus = e.bState; break;
+			case InputEvent::Type::MOUSE_FOCUS: bHasMouseFocus = e.bState; break;
 			}
-		};
-
-		ScanHardware(pKeyboardState, pKeyOldState, pKeyNewState, 256);
-		ScanHardware(pMouseState, pMouseOldState, pMouseNewState, nMouseButtons);
-
-		// Cache mouse coordinates so they remain consistent during frame
-		vMousePos = vMousePosCache;
-		nMouseWheelDelta = nMouseWheelDeltaCache;
-		nMouseWheelDeltaCache = 0;
+			vFrameInput.push_back(e);
+		}
 
 		//	renderer->ClearBuffer(olc::BLACK, true);
 
@@ -3195,59 +4205,116 @@ namespace olc
 			if (!OnUserUpdate(fElapsedTime)) bAtomActive = false;
 		}
 		for (auto& ext : vExtensions) ext->OnAfterUserUpdate(fElapsedTime);
+	}
 
-		// Display Frame
-		renderer->UpdateViewport(vViewPos, vViewSize);
-		renderer->ClearBuffer(olc::BLACK, true);
-
+	void PixelGameEngine::olc_HandOverFrame()
+	{
 		// Layer 0 must always exist
 		vLayers[0].bUpdate = true;
 		vLayers[0].bShow = true;
 		SetDecalMode(DecalMode::NORMAL);
+
+		for (auto& layer : vLayers)
+		{
+			LayerPresent& present = layer.present;
+			present.vOffset = layer.vOffset;
+			present.vScale = layer.vScale;
+			present.bShow = layer.bShow;
+			present.bUpdate |= layer.bUpdate;
+			present.tint = layer.tint;
+			present.funcHook = layer.funcHook;
+			present.vecDecalInstance.clear();
+			std::swap(present.vecDecalInstance, layer.vecDecalInstance);
+			layer.bUpdate = false;
+
+			if (!bPipelined) continue;
+
+			// The frame just made goes to the presented half, the half drawn to next only needs
+			// what this frame wrote to be the same. A new half is uploaded whole
+			olc::Sprite* pDraw = layer.pDrawTarget.Sprite();
+			if (!present.pSprite || present.pSprite->width != pDraw->width || present.pSprite->height != pDraw->height)
+			{
+				present.pSprite = std::make_unique<olc::Sprite>(pDraw->width, pDraw->height);
+				present.pSprite->pColData = pDraw->pColData;
+				present.bUpdate = true;
+			}
+			else
+			{
+				const olc::vi2d pos = pDraw->GetDirtyPos(), size = pDraw->GetDirtySize();
+				std::swap(pDraw->pColData, present.pSprite->pColData);
+				present.pSprite->SetDirty(pos.x, pos.y, size.x, size.y);
+				for (int32_t y = pos.y; y < pos.y + size.y; y++)
+				{
+					const olc::Pixel* pSrc = present.pSprite->GetData() + y * pDraw->width + pos.x;
+					std::copy(pSrc, pSrc + size.x, pDraw->GetData() + y * pDraw->width + pos.x);
+				}
+			}
+			pDraw->ClearDirty();
+			layer.pDrawTarget.Decal()->sprite = present.pSprite.get();
+		}
+
+		m_tpPresent = m_tp2;
+		bPresentInput = !vFrameInput.empty();
+		if (bPresentInput) m_tpPresentInput = vFrameInput.front().tpTime;
+
+		// Update Title Bar
+		nFrameCount++;
+		if (fFrameTimer >= 1.0f)
+		{
+			nLastFPS = nFrameCount;
+			fFrameTimer -= 1.0f;
+			std::string sTitle = sAppName + " - FPS: " + std::to_string(nFrameCount);
+			platform->SetWindowTitle(sTitle);
+			nFrameCount = 0;
+		}
+	}
+
+	void PixelGameEngine::olc_PresentFrame()
+	{
+		// Display Frame
+		renderer->UpdateViewport(vViewPos, vViewSize);
+		renderer->ClearBuffer(olc::BLACK, true);
 		renderer->PrepareDrawing();
 
 		for (auto layer = vLayers.rbegin(); layer != vLayers.rend(); ++layer)
 		{
-			if (layer->bShow)
+			LayerPresent& present = layer->present;
+			if (present.bShow)
 			{
-				if (layer->funcHook == nullptr)
+				if (present.funcHook == nullptr)
 				{
 					renderer->ApplyTexture(layer->pDrawTarget.Decal()->id);
-					if (layer->bUpdate)
+					if (present.bUpdate)
 					{
-						layer->pDrawTarget.Decal()->Update();
-						layer->bUpdate = false;
+						layer->pDrawTarget.Decal()->UpdateDirty();
+						present.bUpdate = false;
 					}
 
-					renderer->DrawLayerQuad(layer->vOffset, layer->vScale, layer->tint);
+					renderer->DrawLayerQuad(present.vOffset, present.vScale, present.tint);
 
 					// Display Decals in order for this layer
-					for (auto& decal : layer->vecDecalInstance)
+					for (auto& decal : present.vecDecalInstance)
 						renderer->DrawDecal(decal);
-					layer->vecDecalInstance.clear();
+					present.vecDecalInstance.clear();
 				}
 				else
 				{
 					// Mwa ha ha.... Have Fun!!!
-					layer->funcHook();
+					present.funcHook();
 				}
 			}
 		}
 
 		// Present Graphics to screen
 		renderer->DisplayFrame();
-
-		// Update Title Bar
-		fFrameTimer += fElapsedTime;
-		nFrameCount++;
-		if (fFrameTimer >= 1.0f)
-		{
-			nLastFPS = nFrameCount;
-			fFrameTimer -= 1.0f;
-			std::string sTitle = sAppName + " - FPS: " + std::to_string(nFrameCount);
-			platform->SetWindowTitle(sTitle);
-			nFrameCount = 0;
-		}
+		const auto tpPresented = std::chrono::system_clock::now();
+		fLastLatency = std::chrono::duration<float>(tpPresented - m_tpPresent).count();
+		if (bPresentInput) fLastInputLatency = std::chrono::duration<float>(tpPresented - m_tpPresentInput).count();
+		nLastUploadBytes = nUploadBytes;
+		nTotalUploadBytes += nUploadBytes;
+		fTotalLatency += fLastLatency;
+		nTotalPresented++;
+		nUploadBytes = 0;
 	}
 
 	void PixelGameEngine::olc_ConstructFontSheet()
@@ -3693,6 +4760,14 @@ namespace olc
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
 		}
 
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			UNUSED(id);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, spr->width);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData() + pos.y * spr->width + pos.x);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		}
+
 		void ReadTexture(uint32_t id, olc::Sprite* spr) override
 		{
 			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
@@ -3801,9 +4876,31 @@ namespace olc
 	typedef void CALLSTYLE locBindVertexArray_t(GLuint array);
 	typedef void CALLSTYLE locGenVertexArrays_t(GLsizei n, GLuint* arrays);
 	typedef void CALLSTYLE locGetShaderInfoLog_t(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+	typedef ptrdiff_t GLintptr;
+	typedef void CALLSTYLE locDeleteBuffers_t(GLsizei n, const GLuint* buffers);
+	typedef void CALLSTYLE locBufferStorage_t(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+	typedef void* CALLSTYLE locMapBufferRange_t(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	typedef GLboolean CALLSTYLE locUnmapBuffer_t(GLenum target);
+	typedef void* CALLSTYLE locFenceSync_t(GLenum condition, GLbitfield flags);
+	typedef GLenum CALLSTYLE locClientWaitSync_t(void* sync, GLbitfield flags, uint64_t timeout);
+	typedef void CALLSTYLE locDeleteSync_t(void* sync);
 
 	constexpr size_t OLC_MAX_VERTS = 128;
 
+	// Define OLC_PBO_RING as 2 or 3 to stage texture uploads through that many pixel buffers, with
+	// no value (or as 1, which is what -DOLC_PBO_RING gives) for 3. The driver then copies an upload
+	// into its texture while the engine thread gets on with the next frame, the buffers are mapped
+	// persistently where OpenGL 4.4 allows it
+#if defined(OLC_PBO_RING) && !defined(OLC_PLATFORM_EMSCRIPTEN)
+	#define OLC_GFX_OPENGL33_PBO
+	#if (OLC_PBO_RING + 0) <= 1
+	constexpr size_t OLC_PBO_BUFFERS = 3;
+	#else
+	constexpr size_t OLC_PBO_BUFFERS = OLC_PBO_RING;
+	#endif
+	static_assert(OLC_PBO_BUFFERS >= 2 && OLC_PBO_BUFFERS <= 3, "OLC_PBO_RING must be 2 or 3");
+#endif
+
 	class Renderer_OGL33 : public olc::Renderer
 	{
 	private:
@@ -3850,6 +4947,30 @@ namespace olc
 		locSwapInterval_t* locSwapInterval = nullptr;
 		locGetShaderInfoLog_t* locGetShaderInfoLog = nullptr;
 
+#if defined(OLC_GFX_OPENGL33_PBO)
+		locDeleteBuffers_t* locDeleteBuffers = nullptr;
+		locBufferStorage_t* locBufferStorage = nullptr;
+		locMapBufferRange_t* locMapBufferRange = nullptr;
+		locUnmapBuffer_t* locUnmapBuffer = nullptr;
+		locFenceSync_t* locFenceSync = nullptr;
+		locClientWaitSync_t* locClientWaitSync = nullptr;
+		locDeleteSync_t* locDeleteSync = nullptr;
+
+		// A pixel buffer an upload is staged in, the fence is signalled once the GPU has read it
+		struct locUploadBuffer
+		{
+			GLuint id = 0;
+			size_t nSize = 0;
+			uint8_t* pMapped = nullptr; // Only when mapped persistently
+			void* sync = nullptr;
+		};
+
+		locUploadBuffer pUploadRing[OLC_PBO_BUFFERS];
+		size_t nUploadNext = 0;
+		bool bUploadRing = false;
+		bool bUploadPersistent = false;
+#endif
+
 		uint32_t m_nFS = 0;
 		uint32_t m_nVS = 0;
 		uint32_t m_nQuadShader = 0;
@@ -3867,6 +4988,105 @@ namespace olc
 
 		olc::Renderable rendBlankQuad;
 
+#if defined(OLC_GFX_OPENGL33_PBO)
+		// Buffers are created as uploads need them, only the entry points are found here
+		void CreateUploadRing()
+		{
+			GLint nMajor = 0, nMinor = 0;
+			glGetIntegerv(0x821B, &nMajor); // GL_MAJOR_VERSION
+			glGetIntegerv(0x821C, &nMinor); // GL_MINOR_VERSION
+
+			// Fences came with 3.2, before that uploads stay synchronous
+			bUploadRing = nMajor > 3 || (nMajor == 3 && nMinor >= 2);
+			bUploadPersistent = nMajor > 4 || (nMajor == 4 && nMinor >= 4);
+			if (!bUploadRing) return;
+
+#if defined(OLC_PLATFORM_X11)
+			using namespace X11;
+#endif
+			locDeleteBuffers = OGL_LOAD(locDeleteBuffers_t, glDeleteBuffers);
+			locMapBufferRange = OGL_LOAD(locMapBufferRange_t, glMapBufferRange);
+			locUnmapBuffer = OGL_LOAD(locUnmapBuffer_t, glUnmapBuffer);
+			locFenceSync = OGL_LOAD(locFenceSync_t, glFenceSync);
+			locClientWaitSync = OGL_LOAD(locClientWaitSync_t, glClientWaitSync);
+			locDeleteSync = OGL_LOAD(locDeleteSync_t, glDeleteSync);
+			if (bUploadPersistent)
+			{
+				locBufferStorage = OGL_LOAD(locBufferStorage_t, glBufferStorage);
+				bUploadPersistent = locBufferStorage != nullptr;
+			}
+			bUploadRing = locDeleteBuffers && locMapBufferRange && locUnmapBuffer && locFenceSync && locClientWaitSync && locDeleteSync;
+		}
+
+		void DestroyUploadRing()
+		{
+			if (!bUploadRing) return;
+			for (auto& buf : pUploadRing)
+			{
+				if (buf.sync != nullptr) locDeleteSync(buf.sync);
+				if (buf.pMapped != nullptr)
+				{
+					locBindBuffer(0x88EC, buf.id); // GL_PIXEL_UNPACK_BUFFER
+					locUnmapBuffer(0x88EC);
+				}
+				if (buf.id != 0) locDeleteBuffers(1, &buf.id);
+				buf = locUploadBuffer{};
+			}
+			locBindBuffer(0x88EC, 0);
+			nUploadNext = 0;
+		}
+
+		// Copies the area into the next buffer of the ring and has the bound texture read it from there.
+		// The driver reads it later, only a buffer it is still reading from OLC_PBO_BUFFERS uploads ago waits
+		void UploadThroughRing(olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size, bool bAllocate)
+		{
+			constexpr GLbitfield MAP_PERSISTENT = 0x0002 | 0x0040 | 0x0080; // WRITE | PERSISTENT | COHERENT
+			constexpr GLbitfield MAP_STREAM = 0x0002 | 0x0008 | 0x0020; // WRITE | INVALIDATE_BUFFER | UNSYNCHRONIZED
+
+			locUploadBuffer& buf = pUploadRing[nUploadNext];
+			nUploadNext = (nUploadNext + 1) % OLC_PBO_BUFFERS;
+			if (buf.sync != nullptr)
+			{
+				locClientWaitSync(buf.sync, 0x00000001, UINT64_MAX); // GL_SYNC_FLUSH_COMMANDS_BIT, no timeout
+				locDeleteSync(buf.sync);
+				buf.sync = nullptr;
+			}
+
+			const size_t nRowBytes = size_t(size.x) * sizeof(olc::Pixel), nBytes = nRowBytes * size_t(size.y);
+			if (buf.id == 0) locGenBuffers(1, &buf.id);
+			locBindBuffer(0x88EC, buf.id); // GL_PIXEL_UNPACK_BUFFER
+			if (buf.nSize < nBytes)
+			{
+				if (bUploadPersistent)
+				{
+					// Storage is immutable, so a bigger buffer is a new one
+					if (buf.pMapped != nullptr) locUnmapBuffer(0x88EC);
+					locDeleteBuffers(1, &buf.id);
+					locGenBuffers(1, &buf.id);
+					locBindBuffer(0x88EC, buf.id);
+					locBufferStorage(0x88EC, GLsizeiptr(nBytes), nullptr, MAP_PERSISTENT);
+					buf.pMapped = (uint8_t*)locMapBufferRange(0x88EC, 0, GLsizeiptr(nBytes), MAP_PERSISTENT);
+				}
+				else
+					locBufferData(0x88EC, GLsizeiptr(nBytes), nullptr, 0x88E0); // GL_STREAM_DRAW
+				buf.nSize = nBytes;
+			}
+
+			// The fence has been waited for, so nothing reads the buffer while it is written
+			uint8_t* pDst = bUploadPersistent ? buf.pMapped : (uint8_t*)locMapBufferRange(0x88EC, 0, GLsizeiptr(nBytes), MAP_STREAM);
+			for (int32_t y = 0; y < size.y; y++)
+				std::memcpy(pDst + y * nRowBytes, spr->GetData() + (pos.y + y) * spr->width + pos.x, nRowBytes);
+			if (!bUploadPersistent) locUnmapBuffer(0x88EC);
+
+			if (bAllocate)
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			else
+				glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			locBindBuffer(0x88EC, 0);
+			buf.sync = locFenceSync(0x9117, 0); // GL_SYNC_GPU_COMMANDS_COMPLETE
+		}
+#endif
+
 	public:
 		void PrepareDevice() override
 		{
@@ -3990,6 +5210,9 @@ namespace olc
 			locEnableVertexAttribArray = OGL_LOAD(locEnableVertexAttribArray_t, glEnableVertexAttribArray);
 			locUseProgram = OGL_LOAD(locUseProgram_t, glUseProgram);
 			locGetShaderInfoLog = OGL_LOAD(locGetShaderInfoLog_t, glGetShaderInfoLog);
+#if defined(OLC_GFX_OPENGL33_PBO)
+			CreateUploadRing();
+#endif
 #if !defined(OLC_PLATFORM_EMSCRIPTEN)
 			locBindVertexArray = OGL_LOAD(locBindVertexArray_t, glBindVertexArray);
 			locGenVertexArrays = OGL_LOAD(locGenVertexArrays_t, glGenVertexArrays);
@@ -4054,6 +5277,10 @@ namespace olc
 
 		olc::rcode DestroyDevice() override
 		{
+#if defined(OLC_GFX_OPENGL33_PBO)
+			DestroyUploadRing();
+#endif
+
 #if defined(OLC_PLATFORM_WINAPI)
 			wglDeleteContext(glRenderContext);
 #endif
@@ -4086,160 +5313,764 @@ namespace olc
 			if (bSync) DwmFlush(); // Woooohooooooo!!!! SMOOOOOOOTH!
 #endif	
 
-#if defined(OLC_PLATFORM_X11)
-			X11::glXSwapBuffers(olc_Display, *olc_Window);
-#endif		
+#if defined(OLC_PLATFORM_X11)
+			X11::glXSwapBuffers(olc_Display, *olc_Window);
+#endif		
+
+#if defined(OLC_PLATFORM_GLUT)
+			glutSwapBuffers();
+#endif
+
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+			eglSwapBuffers(olc_Display, olc_Surface);
+#endif
+		}
+
+		void PrepareDrawing() override
+		{
+			glEnable(GL_BLEND);
+			nDecalMode = DecalMode::NORMAL;
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			locUseProgram(m_nQuadShader);
+			locBindVertexArray(m_vaQuad);
+
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+			locVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
+			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(locVertex), (void*)(3 * sizeof(float))); locEnableVertexAttribArray(1);
+			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(5 * sizeof(float)));	locEnableVertexAttribArray(2);
+#endif
+		}
+
+		void SetDecalMode(const olc::DecalMode& mode) override
+		{
+			if (mode != nDecalMode)
+			{
+				switch (mode)
+				{
+				case olc::DecalMode::NORMAL: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
+				case olc::DecalMode::ADDITIVE: glBlendFunc(GL_SRC_ALPHA, GL_ONE); break;
+				case olc::DecalMode::MULTIPLICATIVE: glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);	break;
+				case olc::DecalMode::STENCIL: glBlendFunc(GL_ZERO, GL_SRC_ALPHA); break;
+				case olc::DecalMode::ILLUMINATE: glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);	break;
+				case olc::DecalMode::WIREFRAME: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
+				}
+
+				nDecalMode = mode;
+			}
+		}
+
+		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
+		{
+			locBindBuffer(0x8892, m_vbQuad);
+			locVertex verts[4] = {
+				{{-1.0f, -1.0f, 1.0}, {0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
+				{{+1.0f, -1.0f, 1.0}, {1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
+				{{-1.0f, +1.0f, 1.0}, {0.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
+				{{+1.0f, +1.0f, 1.0}, {1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
+			};
+
+			locBufferData(0x8892, sizeof(locVertex) * 4, verts, 0x88E0);
+			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		}
+
+		void DrawDecal(const olc::DecalInstance& decal) override
+		{
+			SetDecalMode(decal.mode);
+			if (decal.decal == nullptr)
+				glBindTexture(GL_TEXTURE_2D, rendBlankQuad.Decal()->id);
+			else
+				glBindTexture(GL_TEXTURE_2D, decal.decal->id);
+
+			locBindBuffer(0x8892, m_vbQuad);
+
+			for (uint32_t i = 0; i < decal.points; i++)
+				pVertexMem[i] = { { decal.pos[i].x, decal.pos[i].y, decal.w[i] }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] };
+
+			locBufferData(0x8892, sizeof(locVertex) * decal.points, pVertexMem, 0x88E0);
+
+			if (nDecalMode == DecalMode::WIREFRAME)
+				glDrawArrays(GL_LINE_LOOP, 0, decal.points);
+			else
+				glDrawArrays(GL_TRIANGLE_FAN, 0, decal.points);
+		}
+
+		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
+		{
+			UNUSED(width);
+			UNUSED(height);
+			uint32_t id = 0;
+			glGenTextures(1, &id);
+			glBindTexture(GL_TEXTURE_2D, id);
+
+			if (filtered)
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			}
+			else
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			}
+
+			if (clamp)
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+			}
+			else
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			}
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+			glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+#endif
+			return id;
+		}
+
+		uint32_t DeleteTexture(const uint32_t id) override
+		{
+			glDeleteTextures(1, &id);
+			return id;
+		}
+
+		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			UNUSED(id);
+#if defined(OLC_GFX_OPENGL33_PBO)
+			if (bUploadRing) { UploadThroughRing(spr, { 0, 0 }, { spr->width, spr->height }, true); return; }
+#endif
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+		}
+
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			UNUSED(id);
+#if defined(OLC_GFX_OPENGL33_PBO)
+			if (bUploadRing) { UploadThroughRing(spr, pos, size, false); return; }
+#endif
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+			// GLES2 has no row length to unpack with, so whole rows go up
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, pos.y, spr->width, size.y, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData() + pos.y * spr->width);
+#else
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, spr->width);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData() + pos.y * spr->width + pos.x);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+		}
+
+		void ReadTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+		}
+
+		void ApplyTexture(uint32_t id) override
+		{
+			glBindTexture(GL_TEXTURE_2D, id);
+		}
+
+		void ClearBuffer(olc::Pixel p, bool bDepth) override
+		{
+			glClearColor(float(p.r) / 255.0f, float(p.g) / 255.0f, float(p.b) / 255.0f, float(p.a) / 255.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+			if (bDepth) glClear(GL_DEPTH_BUFFER_BIT);
+		}
+
+		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			glViewport(pos.x, pos.y, size.x, size.y);
+		}
+	};
+}
+#endif
+// O------------------------------------------------------------------------------O
+// | END RENDERER: OpenGL 3.3 (3.0 es) (sh-sh-sh-shaders....)                     |
+// O------------------------------------------------------------------------------O
+#pragma endregion
+
+#pragma region renderer_software
+// O------------------------------------------------------------------------------O
+// | START RENDERER: Software, composites the frame in memory, no GPU required    |
+// O------------------------------------------------------------------------------O
+// Select it before including the engine with
+//     #define OLC_GFX_CUSTOM_EX
+//     #define OLC_RENDERER_CUSTOM_EX olc::Renderer_Software
+// Layers and decals are recorded through the frame and composited when it is displayed.
+// The frame is cut into tiles which a pool of threads composites in parallel, every tile
+// runs the whole command list in order, so the result does not depend on the thread count.
+// Textures are sampled nearest, blend modes follow the OpenGL renderers.
+namespace olc
+{
+	class Renderer_Software : public olc::Renderer
+	{
+	private:
+		struct Texture
+		{
+			int32_t width = 0;
+			int32_t height = 0;
+			bool clamp = true;
+			bool used = false;
+			std::vector<olc::Pixel> data;
+		};
+
+		// Decal vertex in screen space, uv still carries the projective w
+		struct Vertex
+		{
+			olc::vf2d pos;
+			olc::vf2d uv;
+			float w = 1.0f;
+			olc::Pixel tint;
+		};
+
+		struct Command
+		{
+			enum class Type { CLEAR, LAYER, DECAL } type = Type::CLEAR;
+			olc::DecalMode mode = olc::DecalMode::NORMAL;
+			olc::DecalStructure structure = olc::DecalStructure::FAN;
+			uint32_t texture = 0;
+			olc::Pixel colour;		// Clear colour or layer tint
+			olc::vf2d offset;
+			olc::vf2d scale;
+			uint32_t first = 0;		// Vertices of a decal
+			uint32_t points = 0;
+			olc::vi2d vMin;			// Inclusive screen bounds
+			olc::vi2d vMax;
+		};
+
+		static constexpr int32_t nTileWidth = 128;
+		static constexpr int32_t nTileHeight = 64;
+
+		// Texture 0 is "no texture", it samples as white
+		std::vector<Texture> vTextures = std::vector<Texture>(1);
+		uint32_t nBoundTexture = 0;
+		olc::DecalMode nDecalMode = olc::DecalMode::NORMAL;
+		olc::Sprite sprFrame;
+		std::vector<Command> vCommands;
+		std::vector<Vertex> vVertices;
+
+		// Compositing threads, the thread that flushes composites tiles as well
+		uint32_t nThreads = 0;
+		std::vector<std::thread> vWorkers;
+		std::mutex muxPool;
+		std::condition_variable cvStart;
+		std::condition_variable cvDone;
+		uint64_t nBatch = 0;
+		uint32_t nBusy = 0;
+		bool bQuit = false;
+		std::atomic<int32_t> nNextTile{ 0 };
+		int32_t nTilesX = 0;
+		int32_t nTiles = 0;
+
+	public:
+		// Composites with the given number of threads, 0 uses one per hardware thread
+		Renderer_Software(uint32_t threads = 0) : nThreads(threads)
+		{}
+
+		~Renderer_Software() override
+		{ StopWorkers(); }
+
+		// The last displayed frame
+		const olc::Sprite& GetFrameBuffer() const
+		{ return sprFrame; }
+
+		void PrepareDevice() override
+		{}
+
+		olc::rcode CreateDevice(std::vector<void*> params, bool bFullScreen, bool bVSYNC) override
+		{
+			UNUSED(params); UNUSED(bFullScreen); UNUSED(bVSYNC);
+			StartWorkers();
+			return olc::rcode::OK;
+		}
+
+		olc::rcode DestroyDevice() override
+		{
+			// The frame buffer is kept, so the last frame can still be read after the run
+			Flush();
+			StopWorkers();
+			vTextures.resize(1);
+			return olc::rcode::OK;
+		}
+
+		void DisplayFrame() override
+		{ Flush(); }
+
+		void PrepareDrawing() override
+		{ nDecalMode = olc::DecalMode::NORMAL; }
+
+		void SetDecalMode(const olc::DecalMode& mode) override
+		{ nDecalMode = mode; }
+
+		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
+		{
+			Command cmd;
+			cmd.type = Command::Type::LAYER;
+			cmd.mode = nDecalMode;
+			cmd.texture = nBoundTexture;
+			cmd.colour = tint;
+			cmd.offset = offset;
+			cmd.scale = scale;
+			cmd.vMin = { 0, 0 };
+			cmd.vMax = { sprFrame.width - 1, sprFrame.height - 1 };
+			vCommands.push_back(cmd);
+		}
+
+		void DrawDecal(const olc::DecalInstance& decal) override
+		{
+			nDecalMode = decal.mode;
+			if (decal.points < (decal.mode == olc::DecalMode::WIREFRAME ? 2u : 3u)) return;
+
+			Command cmd;
+			cmd.type = Command::Type::DECAL;
+			cmd.mode = decal.mode;
+			cmd.structure = decal.structure;
+			cmd.texture = decal.decal == nullptr ? 0 : uint32_t(decal.decal->id);
+			cmd.first = uint32_t(vVertices.size());
+			cmd.points = decal.points;
+
+			olc::vf2d vMin, vMax;
+			for (uint32_t i = 0; i < decal.points; i++)
+			{
+				const olc::vf2d p = {
+					(decal.pos[i].x + 1.0f) * 0.5f * float(sprFrame.width),
+					(1.0f - decal.pos[i].y) * 0.5f * float(sprFrame.height) };
+				vVertices.push_back({ p, decal.uv[i], decal.w[i], decal.tint[i] });
+				vMin = i == 0 ? p : vMin.min(p);
+				vMax = i == 0 ? p : vMax.max(p);
+			}
+
+			cmd.vMin = { std::max(0, int32_t(std::floor(vMin.x))), std::max(0, int32_t(std::floor(vMin.y))) };
+			cmd.vMax = { std::min(sprFrame.width - 1, int32_t(std::ceil(vMax.x))), std::min(sprFrame.height - 1, int32_t(std::ceil(vMax.y))) };
+			if (cmd.vMin.x > cmd.vMax.x || cmd.vMin.y > cmd.vMax.y)
+			{
+				vVertices.resize(cmd.first);
+				return;
+			}
+
+			vCommands.push_back(cmd);
+		}
+
+		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
+		{
+			UNUSED(filtered);
+			uint32_t id = 1;
+			while (id < vTextures.size() && vTextures[id].used) id++;
+			if (id == vTextures.size()) vTextures.emplace_back();
+			vTextures[id] = Texture{ int32_t(width), int32_t(height), clamp, true, {} };
+			return id;
+		}
+
+		uint32_t DeleteTexture(const uint32_t id) override
+		{
+			if (UsesTexture(id)) Flush();
+			if (id > 0 && id < vTextures.size()) vTextures[id] = Texture{};
+			return id;
+		}
+
+		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			// Drawing already recorded must see the old contents
+			if (UsesTexture(id)) Flush();
+			Texture& tex = vTextures[id];
+			tex.width = spr->width;
+			tex.height = spr->height;
+			tex.data.assign(spr->GetData(), spr->GetData() + spr->width * spr->height);
+		}
+
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			Texture& tex = vTextures[id];
+			if (tex.data.size() != size_t(spr->width) * size_t(spr->height)) { UpdateTexture(id, spr); return; }
+			if (UsesTexture(id)) Flush();
+			for (int32_t y = pos.y; y < pos.y + size.y; y++)
+				std::copy_n(spr->GetData() + y * spr->width + pos.x, size.x, tex.data.begin() + y * tex.width + pos.x);
+		}
+
+		void ReadTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			const Texture& tex = vTextures[id];
+			if (tex.width == spr->width && tex.height == spr->height && !tex.data.empty())
+				std::copy(tex.data.begin(), tex.data.end(), spr->GetData());
+		}
+
+		void ApplyTexture(uint32_t id) override
+		{ nBoundTexture = id; }
+
+		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			UNUSED(pos);
+			if (size.x != sprFrame.width || size.y != sprFrame.height)
+			{
+				Flush();
+				sprFrame.width = size.x;
+				sprFrame.height = size.y;
+				sprFrame.pColData.assign(size_t(size.x) * size_t(size.y), olc::BLACK);
+			}
+		}
+
+		void ClearBuffer(olc::Pixel p, bool bDepth) override
+		{
+			UNUSED(bDepth);
+			// Nothing recorded before a clear can show
+			vCommands.clear();
+			vVertices.clear();
 
-#if defined(OLC_PLATFORM_GLUT)
-			glutSwapBuffers();
-#endif
+			Command cmd;
+			cmd.colour = p;
+			cmd.vMin = { 0, 0 };
+			cmd.vMax = { sprFrame.width - 1, sprFrame.height - 1 };
+			vCommands.push_back(cmd);
+		}
 
-#if defined(OLC_PLATFORM_EMSCRIPTEN)
-			eglSwapBuffers(olc_Display, olc_Surface);
-#endif
+	private:
+		bool UsesTexture(uint32_t id) const
+		{
+			for (const auto& cmd : vCommands)
+				if (cmd.type != Command::Type::CLEAR && cmd.texture == id) return true;
+			return false;
 		}
 
-		void PrepareDrawing() override
+		void StartWorkers()
 		{
-			glEnable(GL_BLEND);
-			nDecalMode = DecalMode::NORMAL;
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			locUseProgram(m_nQuadShader);
-			locBindVertexArray(m_vaQuad);
+			StopWorkers();
+			const uint32_t n = nThreads > 0 ? nThreads : std::max(1u, std::thread::hardware_concurrency());
+			bQuit = false;
+			for (uint32_t i = 1; i < n; i++)
+				vWorkers.emplace_back(&Renderer_Software::WorkerLoop, this);
+		}
 
-#if defined(OLC_PLATFORM_EMSCRIPTEN)
-			locVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
-			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(locVertex), (void*)(3 * sizeof(float))); locEnableVertexAttribArray(1);
-			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(5 * sizeof(float)));	locEnableVertexAttribArray(2);
-#endif
+		void StopWorkers()
+		{
+			{
+				std::lock_guard<std::mutex> lock(muxPool);
+				bQuit = true;
+			}
+			cvStart.notify_all();
+			for (auto& t : vWorkers) t.join();
+			vWorkers.clear();
 		}
 
-		void SetDecalMode(const olc::DecalMode& mode) override
+		void WorkerLoop()
 		{
-			if (mode != nDecalMode)
+			uint64_t nSeen = 0;
+			for (;;)
 			{
-				switch (mode)
 				{
-				case olc::DecalMode::NORMAL: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
-				case olc::DecalMode::ADDITIVE: glBlendFunc(GL_SRC_ALPHA, GL_ONE); break;
-				case olc::DecalMode::MULTIPLICATIVE: glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);	break;
-				case olc::DecalMode::STENCIL: glBlendFunc(GL_ZERO, GL_SRC_ALPHA); break;
-				case olc::DecalMode::ILLUMINATE: glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);	break;
-				case olc::DecalMode::WIREFRAME: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
+					std::unique_lock<std::mutex> lock(muxPool);
+					cvStart.wait(lock, [&] { return bQuit || nBatch != nSeen; });
+					if (bQuit) return;
+					nSeen = nBatch;
 				}
 
-				nDecalMode = mode;
+				CompositeTiles();
+
+				std::lock_guard<std::mutex> lock(muxPool);
+				if (--nBusy == 0) cvDone.notify_one();
 			}
 		}
 
-		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
+		// Composites everything recorded so far into the frame
+		void Flush()
 		{
-			locBindBuffer(0x8892, m_vbQuad);
-			locVertex verts[4] = {
-				{{-1.0f, -1.0f, 1.0}, {0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
-				{{+1.0f, -1.0f, 1.0}, {1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
-				{{-1.0f, +1.0f, 1.0}, {0.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
-				{{+1.0f, +1.0f, 1.0}, {1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
-			};
+			if (vCommands.empty() || sprFrame.width <= 0 || sprFrame.height <= 0) return;
 
-			locBufferData(0x8892, sizeof(locVertex) * 4, verts, 0x88E0);
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-		}
+			nTilesX = (sprFrame.width + nTileWidth - 1) / nTileWidth;
+			nTiles = nTilesX * ((sprFrame.height + nTileHeight - 1) / nTileHeight);
+			nNextTile = 0;
 
-		void DrawDecal(const olc::DecalInstance& decal) override
-		{
-			SetDecalMode(decal.mode);
-			if (decal.decal == nullptr)
-				glBindTexture(GL_TEXTURE_2D, rendBlankQuad.Decal()->id);
-			else
-				glBindTexture(GL_TEXTURE_2D, decal.decal->id);
+			if (!vWorkers.empty())
+			{
+				{
+					std::lock_guard<std::mutex> lock(muxPool);
+					nBusy = uint32_t(vWorkers.size());
+					nBatch++;
+				}
+				cvStart.notify_all();
+			}
 
-			locBindBuffer(0x8892, m_vbQuad);
+			CompositeTiles();
 
-			for (uint32_t i = 0; i < decal.points; i++)
-				pVertexMem[i] = { { decal.pos[i].x, decal.pos[i].y, decal.w[i] }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] };
+			if (!vWorkers.empty())
+			{
+				std::unique_lock<std::mutex> lock(muxPool);
+				cvDone.wait(lock, [&] { return nBusy == 0; });
+			}
 
-			locBufferData(0x8892, sizeof(locVertex) * decal.points, pVertexMem, 0x88E0);
+			vCommands.clear();
+			vVertices.clear();
+		}
 
-			if (nDecalMode == DecalMode::WIREFRAME)
-				glDrawArrays(GL_LINE_LOOP, 0, decal.points);
-			else
-				glDrawArrays(GL_TRIANGLE_FAN, 0, decal.points);
+		void CompositeTiles()
+		{
+			for (int32_t nTile = nNextTile++; nTile < nTiles; nTile = nNextTile++)
+			{
+				const olc::vi2d vTileMin = { (nTile % nTilesX) * nTileWidth, (nTile / nTilesX) * nTileHeight };
+				const olc::vi2d vTileMax = {
+					std::min(vTileMin.x + nTileWidth, sprFrame.width) - 1,
+					std::min(vTileMin.y + nTileHeight, sprFrame.height) - 1 };
+
+				for (const auto& cmd : vCommands)
+				{
+					const olc::vi2d vMin = vTileMin.max(cmd.vMin), vMax = vTileMax.min(cmd.vMax);
+					if (vMin.x > vMax.x || vMin.y > vMax.y) continue;
+
+					if (cmd.type == Command::Type::CLEAR)
+					{
+						for (int32_t y = vMin.y; y <= vMax.y; y++)
+							std::fill_n(sprFrame.GetData() + y * sprFrame.width + vMin.x, vMax.x - vMin.x + 1, cmd.colour);
+					}
+					else if (cmd.type == Command::Type::LAYER)
+						CompositeLayer(cmd, vMin, vMax);
+					else if (cmd.mode == olc::DecalMode::WIREFRAME)
+					{
+						// A line loop like the OpenGL renderers, each segment leaves out its end
+						for (uint32_t i = 0; i < cmd.points; i++)
+							CompositeLine(cmd, cmd.first + i, cmd.first + (i + 1) % cmd.points, vMin, vMax);
+					}
+					else
+					{
+						const uint32_t f = cmd.first;
+						if (cmd.structure == olc::DecalStructure::FAN)
+						{
+							for (uint32_t i = 1; i + 1 < cmd.points; i++) CompositeTriangle(cmd, f, f + i, f + i + 1, vMin, vMax);
+						}
+						else if (cmd.structure == olc::DecalStructure::STRIP)
+						{
+							for (uint32_t i = 0; i + 2 < cmd.points; i++) CompositeTriangle(cmd, f + i, f + i + 1, f + i + 2, vMin, vMax);
+						}
+						else if (cmd.structure == olc::DecalStructure::LIST)
+						{
+							for (uint32_t i = 0; i + 2 < cmd.points; i += 3) CompositeTriangle(cmd, f + i, f + i + 1, f + i + 2, vMin, vMax);
+						}
+					}
+				}
+			}
 		}
 
-		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
+		void CompositeLayer(const Command& cmd, const olc::vi2d& vMin, const olc::vi2d& vMax)
 		{
-			UNUSED(width);
-			UNUSED(height);
-			uint32_t id = 0;
-			glGenTextures(1, &id);
-			glBindTexture(GL_TEXTURE_2D, id);
+			const Texture& tex = vTextures[cmd.texture];
+			const int32_t w = sprFrame.width, h = sprFrame.height, n = vMax.x - vMin.x + 1;
+			olc::Pixel* pFrame = sprFrame.GetData();
 
-			if (filtered)
+			// The usual case, an unscaled layer the size of the frame is blended pixel for pixel
+			const bool bDirect = cmd.offset.x == 0.0f && cmd.offset.y == 0.0f && cmd.scale.x == 1.0f && cmd.scale.y == 1.0f
+				&& cmd.colour == olc::WHITE && tex.width == w && tex.height == h && !tex.data.empty();
+
+			if (bDirect)
 			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				for (int32_t y = vMin.y; y <= vMax.y; y++)
+					BlendSpan(cmd.mode, pFrame + y * w + vMin.x, tex.data.data() + y * w + vMin.x, n);
+				return;
 			}
-			else
+
+			// Texels are picked per column and per row, the same columns are used by every row
+			int32_t nColumn[nTileWidth];
+			for (int32_t x = vMin.x; x <= vMax.x && !tex.data.empty(); x++)
+				nColumn[x - vMin.x] = TexelIndex(cmd.offset.x + cmd.scale.x * (float(x) + 0.5f) / float(w), tex.width, tex.clamp);
+
+			olc::Pixel pSource[nTileWidth];
+			for (int32_t y = vMin.y; y <= vMax.y; y++)
 			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				if (tex.data.empty())
+					std::fill_n(pSource, n, cmd.colour);
+				else
+				{
+					const olc::Pixel* pRow = tex.data.data() + TexelIndex(cmd.offset.y + cmd.scale.y * (float(y) + 0.5f) / float(h), tex.height, tex.clamp) * tex.width;
+					for (int32_t i = 0; i < n; i++) pSource[i] = pRow[nColumn[i]];
+					if (cmd.colour != olc::WHITE)
+						for (int32_t i = 0; i < n; i++) pSource[i] = Modulate(pSource[i], cmd.colour);
+				}
+				BlendSpan(cmd.mode, pFrame + y * w + vMin.x, pSource, n);
 			}
+		}
 
-			if (clamp)
+		// Fills the pixels whose centres lie inside the triangle. Shared edges belong to exactly one
+		// of the triangles, so translucent decals made of several triangles have no seams
+		void CompositeTriangle(const Command& cmd, uint32_t i0, uint32_t i1, uint32_t i2, const olc::vi2d& vClipMin, const olc::vi2d& vClipMax)
+		{
+			const Vertex* v0 = &vVertices[i0], * v1 = &vVertices[i1], * v2 = &vVertices[i2];
+			auto Edge = [](const olc::vf2d& a, const olc::vf2d& b, const olc::vf2d& p) { return (b - a).cross(p - a); };
+			float fArea = Edge(v0->pos, v1->pos, v2->pos);
+			if (fArea == 0.0f) return;
+			if (fArea < 0.0f) { std::swap(v1, v2); fArea = -fArea; }
+
+			auto IsTopLeft = [](const olc::vf2d& a, const olc::vf2d& b) { return a.y < b.y || (a.y == b.y && b.x < a.x); };
+			const bool bTL0 = IsTopLeft(v1->pos, v2->pos), bTL1 = IsTopLeft(v2->pos, v0->pos), bTL2 = IsTopLeft(v0->pos, v1->pos);
+
+			const int32_t sx = std::max(vClipMin.x, int32_t(std::floor(std::min({ v0->pos.x, v1->pos.x, v2->pos.x }))));
+			const int32_t ex = std::min(vClipMax.x, int32_t(std::ceil(std::max({ v0->pos.x, v1->pos.x, v2->pos.x }))));
+			const int32_t sy = std::max(vClipMin.y, int32_t(std::floor(std::min({ v0->pos.y, v1->pos.y, v2->pos.y }))));
+			const int32_t ey = std::min(vClipMax.y, int32_t(std::ceil(std::max({ v0->pos.y, v1->pos.y, v2->pos.y }))));
+
+			const Texture& tex = vTextures[cmd.texture];
+			const bool bFlatTint = v0->tint == v1->tint && v0->tint == v2->tint;
+			olc::Pixel* pFrame = sprFrame.GetData();
+			olc::Pixel pSource[nTileWidth];
+
+			for (int32_t y = sy; y <= ey; y++)
 			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+				// Inside is a single run of the row, the triangle is convex
+				int32_t nRunStart = -1, nRunEnd = -1;
+				for (int32_t x = sx; x <= ex; x++)
+				{
+					const olc::vf2d p(float(x) + 0.5f, float(y) + 0.5f);
+					const float e0 = Edge(v1->pos, v2->pos, p), e1 = Edge(v2->pos, v0->pos, p), e2 = Edge(v0->pos, v1->pos, p);
+					if (e0 < 0.0f || (e0 == 0.0f && !bTL0) || e1 < 0.0f || (e1 == 0.0f && !bTL1) || e2 < 0.0f || (e2 == 0.0f && !bTL2))
+					{
+						if (nRunStart >= 0) break;
+						continue;
+					}
+
+					const float l0 = e0 / fArea, l1 = e1 / fArea, l2 = e2 / fArea;
+					const float q = l0 * v0->w + l1 * v1->w + l2 * v2->w;
+					const float u = (l0 * v0->uv.x + l1 * v1->uv.x + l2 * v2->uv.x) / q;
+					const float v = (l0 * v0->uv.y + l1 * v1->uv.y + l2 * v2->uv.y) / q;
+
+					olc::Pixel tint = v0->tint;
+					if (!bFlatTint)
+					{
+						auto Mix = [&](uint8_t olc::Pixel::* c)
+						{ return uint8_t(l0 * float(v0->tint.*c) + l1 * float(v1->tint.*c) + l2 * float(v2->tint.*c) + 0.5f); };
+						tint = olc::Pixel(Mix(&olc::Pixel::r), Mix(&olc::Pixel::g), Mix(&olc::Pixel::b), Mix(&olc::Pixel::a));
+					}
+
+					if (nRunStart < 0) nRunStart = x;
+					nRunEnd = x;
+					pSource[x - sx] = Modulate(Sample(tex, u, v), tint);
+				}
+
+				if (nRunStart >= 0)
+					BlendSpan(cmd.mode, pFrame + y * sprFrame.width + nRunStart, pSource + (nRunStart - sx), nRunEnd - nRunStart + 1);
 			}
-			else
+		}
+
+		// Steps the whole line the same way in every tile, so tiles agree on its pixels
+		void CompositeLine(const Command& cmd, uint32_t i0, uint32_t i1, const olc::vi2d& vClipMin, const olc::vi2d& vClipMax)
+		{
+			const Vertex& a = vVertices[i0], & b = vVertices[i1];
+			const int32_t x0 = int32_t(std::floor(a.pos.x)), y0 = int32_t(std::floor(a.pos.y));
+			const int32_t dx = int32_t(std::floor(b.pos.x)) - x0, dy = int32_t(std::floor(b.pos.y)) - y0;
+			const int32_t nSteps = std::max(std::abs(dx), std::abs(dy));
+
+			const Texture& tex = vTextures[cmd.texture];
+			olc::Pixel* pFrame = sprFrame.GetData();
+			for (int32_t i = 0; i < nSteps; i++)
 			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+				const int32_t x = x0 + (dx * i * 2 + (dx < 0 ? -nSteps : nSteps)) / (nSteps * 2);
+				const int32_t y = y0 + (dy * i * 2 + (dy < 0 ? -nSteps : nSteps)) / (nSteps * 2);
+				if (x < vClipMin.x || x > vClipMax.x || y < vClipMin.y || y > vClipMax.y) continue;
+
+				const float t = float(i) / float(nSteps);
+				const float q = a.w + (b.w - a.w) * t;
+				const olc::vf2d uv = (a.uv + (b.uv - a.uv) * t) / q;
+				const olc::Pixel tint = olc::PixelLerp(a.tint, b.tint, t);
+				const olc::Pixel p = Modulate(Sample(tex, uv.x, uv.y), tint);
+				BlendSpan(cmd.mode, pFrame + y * sprFrame.width + x, &p, 1);
 			}
-#if !defined(OLC_PLATFORM_EMSCRIPTEN)
-			glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-#endif
-			return id;
 		}
 
-		uint32_t DeleteTexture(const uint32_t id) override
+		// Nearest texel of a texture coordinate along one axis
+		static int32_t TexelIndex(float t, int32_t size, bool clamp)
 		{
-			glDeleteTextures(1, &id);
-			return id;
+			int32_t i = int32_t(std::floor(t * float(size)));
+			if (clamp) return std::max(0, std::min(i, size - 1));
+			i %= size;
+			return i < 0 ? i + size : i;
 		}
 
-		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		static olc::Pixel Sample(const Texture& tex, float u, float v)
 		{
-			UNUSED(id);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			if (tex.data.empty()) return olc::WHITE;
+			return tex.data[TexelIndex(v, tex.height, tex.clamp) * tex.width + TexelIndex(u, tex.width, tex.clamp)];
 		}
 
-		void ReadTexture(uint32_t id, olc::Sprite* spr) override
+		static olc::Pixel Modulate(olc::Pixel p, olc::Pixel tint)
 		{
-			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			return olc::Pixel(
+				uint8_t((p.r * tint.r + 127) / 255), uint8_t((p.g * tint.g + 127) / 255),
+				uint8_t((p.b * tint.b + 127) / 255), uint8_t((p.a * tint.a + 127) / 255));
 		}
 
-		void ApplyTexture(uint32_t id) override
+		// The OpenGL blend functions of each mode, applied to all four channels
+		static olc::Pixel Blend(olc::DecalMode mode, olc::Pixel d, olc::Pixel s)
 		{
-			glBindTexture(GL_TEXTURE_2D, id);
+			auto Channel = [&](uint8_t olc::Pixel::* c) -> uint8_t
+			{
+				const int sc = s.*c, dc = d.*c, a = s.a;
+				switch (mode)
+				{
+				case olc::DecalMode::ADDITIVE: return uint8_t(std::min(255, dc + (sc * a + 127) / 255));
+				case olc::DecalMode::MULTIPLICATIVE: return uint8_t(std::min(255, (sc * dc + dc * (255 - a) + 127) / 255));
+				case olc::DecalMode::STENCIL: return uint8_t((dc * a + 127) / 255);
+				case olc::DecalMode::ILLUMINATE: return uint8_t((sc * (255 - a) + dc * a + 127) / 255);
+				default: return uint8_t((sc * a + dc * (255 - a) + 127) / 255);
+				}
+			};
+			return olc::Pixel(Channel(&olc::Pixel::r), Channel(&olc::Pixel::g), Channel(&olc::Pixel::b), Channel(&olc::Pixel::a));
 		}
 
-		void ClearBuffer(olc::Pixel p, bool bDepth) override
+#if defined(OLC_SIMD_SSE2)
+		// (x + 127) / 255 for the 16 bit lanes, exact for every product of two bytes
+		static __m128i Div255(__m128i x)
 		{
-			glClearColor(float(p.r) / 255.0f, float(p.g) / 255.0f, float(p.b) / 255.0f, float(p.a) / 255.0f);
-			glClear(GL_COLOR_BUFFER_BIT);
-			if (bDepth) glClear(GL_DEPTH_BUFFER_BIT);
+			x = _mm_add_epi16(x, _mm_set1_epi16(127));
+			return _mm_srli_epi16(_mm_add_epi16(x, _mm_add_epi16(_mm_set1_epi16(1), _mm_srli_epi16(x, 8))), 8);
 		}
 
-		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
+		// Four pixels of source alpha, spread over every channel, widened to 16 bits
+		static void SplitAlpha(__m128i s, __m128i& lo, __m128i& hi)
 		{
-			glViewport(pos.x, pos.y, size.x, size.y);
+			__m128i a = _mm_srli_epi32(s, 24);
+			a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+			a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+			lo = _mm_unpacklo_epi8(a, _mm_setzero_si128());
+			hi = _mm_unpackhi_epi8(a, _mm_setzero_si128());
+		}
+#endif
+
+		// Blends n source pixels over the frame, NORMAL and ADDITIVE four at a time
+		static void BlendSpan(olc::DecalMode mode, olc::Pixel* pDst, const olc::Pixel* pSrc, int32_t n)
+		{
+			int32_t i = 0;
+#if defined(OLC_SIMD_SSE2)
+			const __m128i zero = _mm_setzero_si128(), full = _mm_set1_epi16(255);
+			if (mode == olc::DecalMode::NORMAL || mode == olc::DecalMode::WIREFRAME || mode == olc::DecalMode::MODEL3D)
+			{
+				for (; i + 4 <= n; i += 4)
+				{
+					const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+					const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + i));
+					__m128i alo, ahi;
+					SplitAlpha(s, alo, ahi);
+					const __m128i lo = Div255(_mm_add_epi16(
+						_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), alo), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, alo))));
+					const __m128i hi = Div255(_mm_add_epi16(
+						_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), ahi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, ahi))));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packus_epi16(lo, hi));
+				}
+			}
+			else if (mode == olc::DecalMode::ADDITIVE)
+			{
+				for (; i + 4 <= n; i += 4)
+				{
+					const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+					const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + i));
+					__m128i alo, ahi;
+					SplitAlpha(s, alo, ahi);
+					const __m128i lo = Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), alo));
+					const __m128i hi = Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), ahi));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_adds_epu8(d, _mm_packus_epi16(lo, hi)));
+				}
+			}
+#endif
+			for (; i < n; i++) pDst[i] = Blend(mode, pDst[i], pSrc[i]);
 		}
 	};
 }
-#endif
 // O------------------------------------------------------------------------------O
-// | END RENDERER: OpenGL 3.3 (3.0 es) (sh-sh-sh-shaders....)                     |
+// | END RENDERER: Software                                                       |
 // O------------------------------------------------------------------------------O
 #pragma endregion
 
@@ -4787,6 +6618,8 @@ namespace olc
 		X11::XVisualInfo* olc_VisualInfo;
 		X11::Colormap                olc_ColourMap;
 		X11::XSetWindowAttributes    olc_SetWindowAttribs;
+		int							 olc_WakePipe[2] = { -1, -1 };
+		bool						 olc_bDetectableAutoRepeat = false;
 
 	public:
 		virtual olc::rcode ApplicationStartUp() override
@@ -4797,6 +6630,7 @@ namespace olc
 		virtual olc::rcode ApplicationCleanUp() override
 		{
 			XDestroyWindow(olc_Display, olc_Window);
+			if (olc_WakePipe[0] >= 0) { close(olc_WakePipe[0]); close(olc_WakePipe[1]); }
 			return olc::rcode::OK;
 		}
 
@@ -4831,6 +6665,10 @@ namespace olc
 			olc_Display = XOpenDisplay(NULL);
 			olc_WindowRoot = DefaultRootWindow(olc_Display);
 
+			// Lets other threads interrupt a wait for events, see WakeSystemEvent()
+			if (pipe(olc_WakePipe) == 0)
+				for (int fd : olc_WakePipe) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
 			// Based on the display capabilities, configure the appearance of the window
 			GLint olc_GLAttribs[] = { GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER, None };
 			olc_VisualInfo = glXChooseVisual(olc_Display, 0, olc_GLAttribs);
@@ -4850,6 +6688,11 @@ namespace olc
 			Atom wmDelete = XInternAtom(olc_Display, "WM_DELETE_WINDOW", true);
 			XSetWMProtocols(olc_Display, olc_Window, &wmDelete, 1);
 
+			// Let a held key repeat as presses alone. Otherwise X11 sends a release before every repeat,
+			// and the input queue would report the key as let go and pressed again each time
+			Bool bDetectable = False;
+			olc_bDetectableAutoRepeat = XkbSetDetectableAutoRepeat(olc_Display, True, &bDetectable) && bDetectable;
+
 			XMapWindow(olc_Display, olc_Window);
 			XStoreName(olc_Display, olc_Window, "OneLoneCoder.com - Pixel Game Engine");
 
@@ -4936,6 +6779,26 @@ namespace olc
 			return olc::OK;
 		}
 
+		virtual olc::rcode WaitSystemEvent() override
+		{
+			using namespace X11;
+			// Xlib may already hold events it read, they would not show on the connection
+			if (XPending(olc_Display)) return olc::OK;
+			// Without the pipe, look out for redraws asked for by other threads now and then
+			const bool bPipe = olc_WakePipe[0] >= 0;
+			pollfd fds[2] = { { XConnectionNumber(olc_Display), POLLIN, 0 }, { olc_WakePipe[0], POLLIN, 0 } };
+			poll(fds, bPipe ? 2 : 1, bPipe ? -1 : 100);
+			char buf[64];
+			while (bPipe && read(olc_WakePipe[0], buf, sizeof(buf)) > 0) {}
+			return olc::OK;
+		}
+
+		virtual void WakeSystemEvent() override
+		{
+			const char c = 0;
+			if (olc_WakePipe[1] >= 0 && write(olc_WakePipe[1], &c, 1) < 0) { /* Already awake */ }
+		}
+
 		virtual olc::rcode HandleSystemEvent() override
 		{
 			using namespace X11;
@@ -4967,6 +6830,14 @@ namespace olc
 				}
 				else if (xev.type == KeyRelease)
 				{
+					// Where the server cannot be asked to, drop the release of a repeat: it comes with
+					// a press of the same key at the same time, and the key is still held
+					if (!olc_bDetectableAutoRepeat && XEventsQueued(olc_Display, QueuedAfterReading))
+					{
+						XEvent xnext;
+						XPeekEvent(olc_Display, &xnext);
+						if (xnext.type == KeyPress && xnext.xkey.keycode == xev.xkey.keycode && xnext.xkey.time == xev.xkey.time) continue;
+					}
 					KeySym sym = XLookupKeysym(&xev.xkey, 0);
 					ptrPGE->olc_UpdateKeyState(mapKeys[sym], false);
 					XKeyEvent* e = (XKeyEvent*)&xev;
@@ -5768,6 +7639,145 @@ extern "C"
 // O------------------------------------------------------------------------------O
 #pragma endregion
 
+#pragma region platform_headless
+// O------------------------------------------------------------------------------O
+// | START PLATFORM: Headless, no window, no input, runs for a set time           |
+// O------------------------------------------------------------------------------O
+// Select it before including the engine with
+//     #define OLC_PLATFORM_CUSTOM_EX olc::Platform_Headless
+// usually together with olc::Renderer_Software. The engine runs frames as fast as it
+// can until the frame or time limit is reached, Start() then returns as usual.
+namespace olc
+{
+	class Platform_Headless : public olc::Platform
+	{
+	public:
+		// Ends the run after this many frames, 0 for no limit
+		static void SetFrameLimit(uint32_t frames)
+		{ nFrameLimit = frames; }
+
+		// Ends the run after this many seconds, 0 for no limit
+		static void SetTimeLimit(float seconds)
+		{ fTimeLimit = seconds; }
+
+		// Frames of the last run
+		static uint32_t GetFrameCount()
+		{ return nFrames; }
+
+		// Seconds from the start of the first frame until the engine thread finished
+		static float GetRunTime()
+		{ return fRunTime; }
+
+		static const std::string& GetWindowTitle()
+		{ return sTitle; }
+
+		// Bytes of sprite data uploaded to textures in the last run, see PixelGameEngine::GetUploadBytes()
+		static uint64_t GetUploadBytes()
+		{ return nUploadBytes; }
+
+		// Frames that were made and presented in the last run, fewer than GetFrameCount() in idle mode
+		static uint32_t GetPresentCount()
+		{ return nPresented; }
+
+		// Mean of PixelGameEngine::GetFrameLatency() over the frames of the last run
+		static float GetMeanLatency()
+		{ return nPresented > 0 ? float(fLatency / double(nPresented)) : 0.0f; }
+
+	public:
+		virtual olc::rcode ApplicationStartUp() override
+		{
+			nFrames = 0;
+			fRunTime = 0.0f;
+			nUploadBytes = 0;
+			fLatency = 0.0;
+			nPresented = 0;
+			return olc::rcode::OK;
+		}
+
+		virtual olc::rcode ApplicationCleanUp() override
+		{ return olc::rcode::OK; }
+
+		virtual olc::rcode ThreadStartUp() override
+		{ return olc::rcode::OK; }
+
+		virtual olc::rcode ThreadCleanUp() override
+		{
+			if (nFrames > 0) fRunTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - tpStart).count();
+			// Read once all frames are presented, in pipelined mode the last two come after the final event
+			nUploadBytes = ptrPGE->nTotalUploadBytes;
+			fLatency = ptrPGE->fTotalLatency;
+			nPresented = ptrPGE->nTotalPresented;
+			renderer->DestroyDevice();
+			return olc::OK;
+		}
+
+		virtual olc::rcode CreateGraphics(bool bFullScreen, bool bEnableVSYNC, const olc::vi2d& vViewPos, const olc::vi2d& vViewSize) override
+		{
+			if (renderer->CreateDevice({}, bFullScreen, bEnableVSYNC) == olc::rcode::OK)
+			{
+				renderer->UpdateViewport(vViewPos, vViewSize);
+				return olc::rcode::OK;
+			}
+			else
+				return olc::rcode::FAIL;
+		}
+
+		virtual olc::rcode CreateWindowPane(const olc::vi2d& vWindowPos, olc::vi2d& vWindowSize, bool bFullScreen) override
+		{
+			UNUSED(vWindowPos); UNUSED(vWindowSize); UNUSED(bFullScreen);
+			return olc::rcode::OK;
+		}
+
+		virtual olc::rcode SetWindowTitle(const std::string& s) override
+		{
+			sTitle = s;
+			return olc::rcode::OK;
+		}
+
+		virtual olc::rcode StartSystemEventLoop() override
+		{ return olc::rcode::OK; }
+
+		// There are no events, so an idle engine sees every frame go by and makes only those asked for
+		virtual olc::rcode WaitSystemEvent() override
+		{ return olc::rcode::OK; }
+
+		// Called at the start of every frame, the frame that reaches a limit is the last one
+		virtual olc::rcode HandleSystemEvent() override
+		{
+			if (nFrames == 0) tpStart = std::chrono::steady_clock::now();
+			nFrames++;
+			fRunTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - tpStart).count();
+			if ((nFrameLimit > 0 && nFrames >= nFrameLimit) || (fTimeLimit > 0.0f && fRunTime >= fTimeLimit))
+				ptrPGE->olc_Terminate();
+			return olc::rcode::OK;
+		}
+
+	private:
+		static uint32_t nFrameLimit;
+		static float fTimeLimit;
+		static uint32_t nFrames;
+		static float fRunTime;
+		static std::string sTitle;
+		static uint64_t nUploadBytes;
+		static double fLatency;
+		static uint32_t nPresented;
+		std::chrono::steady_clock::time_point tpStart;
+	};
+
+	uint32_t Platform_Headless::nFrameLimit = 0;
+	float Platform_Headless::fTimeLimit = 0.0f;
+	uint32_t Platform_Headless::nFrames = 0;
+	float Platform_Headless::fRunTime = 0.0f;
+	std::string Platform_Headless::sTitle;
+	uint64_t Platform_Headless::nUploadBytes = 0;
+	double Platform_Headless::fLatency = 0.0;
+	uint32_t Platform_Headless::nPresented = 0;
+}
+// O------------------------------------------------------------------------------O
+// | END PLATFORM: Headless                                                       |
+// O------------------------------------------------------------------------------O
+#pragma endregion
+
 
 #endif // Headless
 